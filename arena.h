@@ -0,0 +1,243 @@
+// Arena de memoria para reutilizar buffers entre invocaciones repetidas de
+// los kernels.
+//
+// La arena mapea bloques con mmap y los pre-toca al crearlos, de modo que
+// los fallos de página se pagan una sola vez. Los bloques de 2 MB o más se
+// alinean a 2 MB y se piden con páginas enormes: primero MAP_HUGETLB (si el
+// sistema tiene páginas reservadas) y si no madvise(MADV_HUGEPAGE) para las
+// páginas enormes transparentes. reservar() sólo avanza un puntero; marca()
+// y volverA() devuelven de golpe todo lo reservado después de la marca y los
+// bloques se conservan para la siguiente llamada. Una vez que la arena ha
+// crecido hasta el pico de un kernel, repetir la llamada no hace ninguna
+// reserva de memoria.
+//
+// Sólo admite tipos trivialmente destructibles: la arena nunca llama
+// destructores.
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <algorithm>
+#include <type_traits>
+
+// Vista de una matriz fila-mayor sobre memoria ajena (por ejemplo, de una
+// Arena). m[i][j] se escribe igual que con vector<vector<T>>.
+template <typename T>
+struct VistaMatriz {
+    T* datos;
+    size_t filas;
+    size_t columnas;
+
+    T* operator[](size_t i) const { return datos + i * columnas; }
+};
+
+class Arena {
+public:
+    static constexpr size_t TAM_PAGINA_ENORME = size_t(2) << 20;
+    static constexpr size_t ALINEACION = 64; // Una línea de caché
+    static constexpr size_t TAM_BLOQUE_MINIMO = size_t(64) << 10;
+
+    // Posición a la que volver con volverA()
+    struct Marca {
+        void* bloque;
+        size_t usado;
+    };
+
+    // Con capacidad_inicial > 0 el primer bloque se mapea y se pre-toca ya
+    explicit Arena(size_t capacidad_inicial = 0) : primero(nullptr), actual(nullptr), usado(0) {
+        if (capacidad_inicial > 0) {
+            actual = primero = mapearBloque(capacidad_inicial + sizeof(Bloque));
+            usado = sizeof(Bloque);
+        }
+    }
+
+    ~Arena() {
+        Bloque* bloque = primero;
+        while (bloque != nullptr) {
+            Bloque* siguiente = bloque->siguiente;
+            munmap(bloque, bloque->tam);
+            bloque = siguiente;
+        }
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // n elementos de T sin inicializar, alineados a una línea de caché
+    template <typename T>
+    T* reservar(size_t n) {
+        static_assert(std::is_trivially_destructible_v<T>, "la arena no llama destructores");
+        constexpr size_t alineacion = std::max(ALINEACION, alignof(T));
+        size_t bytes = std::max<size_t>(n * sizeof(T), 1);
+
+        while (true) {
+            if (actual != nullptr) {
+                size_t inicio = (usado + alineacion - 1) & ~(alineacion - 1);
+                if (inicio + bytes <= actual->tam) {
+                    usado = inicio + bytes;
+                    return reinterpret_cast<T*>(reinterpret_cast<char*>(actual) + inicio);
+                }
+                // No cabe: pasar al siguiente bloque ya mapeado, si lo hay
+                if (actual->siguiente != nullptr) {
+                    actual = actual->siguiente;
+                    usado = sizeof(Bloque);
+                    continue;
+                }
+            }
+
+            // Cada bloque nuevo es al menos tan grande como el anterior
+            size_t anterior = actual != nullptr ? actual->tam : TAM_BLOQUE_MINIMO;
+            Bloque* nuevo = mapearBloque(std::max(bytes + sizeof(Bloque) + alineacion, anterior));
+            if (actual != nullptr) {
+                actual->siguiente = nuevo;
+            } else {
+                primero = nuevo;
+            }
+            actual = nuevo;
+            usado = sizeof(Bloque);
+        }
+    }
+
+    template <typename T>
+    VistaMatriz<T> reservarMatriz(size_t filas, size_t columnas) {
+        return {reservar<T>(filas * columnas), filas, columnas};
+    }
+
+    Marca marca() const { return {actual, usado}; }
+
+    void volverA(Marca m) {
+        actual = static_cast<Bloque*>(m.bloque);
+        usado = m.usado;
+        if (actual == nullptr) {
+            actual = primero;
+            usado = sizeof(Bloque);
+        }
+    }
+
+    // Libera todo lo reservado; los bloques quedan mapeados
+    void reiniciar() {
+        actual = primero;
+        usado = sizeof(Bloque);
+    }
+
+    size_t numBloques() const {
+        size_t total = 0;
+        for (Bloque* b = primero; b != nullptr; b = b->siguiente) ++total;
+        return total;
+    }
+
+    size_t bytesMapeados() const {
+        size_t total = 0;
+        for (Bloque* b = primero; b != nullptr; b = b->siguiente) total += b->tam;
+        return total;
+    }
+
+    // Bytes en bloques pedidos con páginas enormes (explícitas o transparentes)
+    size_t bytesPaginasEnormes() const {
+        size_t total = 0;
+        for (Bloque* b = primero; b != nullptr; b = b->siguiente) {
+            if (b->paginas_enormes) total += b->tam;
+        }
+        return total;
+    }
+
+private:
+    // Cabecera al principio de cada bloque mapeado: la lista de bloques vive
+    // dentro de la propia arena
+    struct Bloque {
+        Bloque* siguiente;
+        size_t tam;
+        bool paginas_enormes;
+    };
+
+    Bloque* primero;
+    Bloque* actual;
+    size_t usado; // Desplazamiento libre dentro de actual
+
+    static Bloque* mapearBloque(size_t bytes) {
+        size_t pagina = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        bool enormes = bytes >= TAM_PAGINA_ENORME;
+        size_t granularidad = enormes ? TAM_PAGINA_ENORME : pagina;
+        bytes = (bytes + granularidad - 1) / granularidad * granularidad;
+
+        void* memoria = MAP_FAILED;
+#ifdef MAP_HUGETLB
+        if (enormes) {
+            memoria = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+#endif
+        if (memoria == MAP_FAILED && enormes) {
+            memoria = mapearAlineado(bytes);
+#ifdef MADV_HUGEPAGE
+            enormes = memoria != MAP_FAILED && madvise(memoria, bytes, MADV_HUGEPAGE) == 0;
+#else
+            enormes = false;
+#endif
+        }
+        if (memoria == MAP_FAILED) {
+            memoria = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        }
+        if (memoria == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        // Pre-tocar cada página para no pagar los fallos dentro del kernel
+        volatile char* p = static_cast<char*>(memoria);
+        for (size_t i = 0; i < bytes; i += pagina) {
+            p[i] = 0;
+        }
+
+        Bloque* bloque = static_cast<Bloque*>(memoria);
+        bloque->siguiente = nullptr;
+        bloque->tam = bytes;
+        bloque->paginas_enormes = enormes;
+        return bloque;
+    }
+
+    // mmap alineado a 2 MB: se pide de más y se recortan los extremos
+    static void* mapearAlineado(size_t bytes) {
+        size_t total = bytes + TAM_PAGINA_ENORME;
+        void* memoria = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memoria == MAP_FAILED) return MAP_FAILED;
+
+        uintptr_t inicio = reinterpret_cast<uintptr_t>(memoria);
+        uintptr_t alineado = (inicio + TAM_PAGINA_ENORME - 1) & ~(uintptr_t(TAM_PAGINA_ENORME) - 1);
+        if (alineado > inicio) {
+            munmap(memoria, alineado - inicio);
+        }
+        uintptr_t fin = inicio + total;
+        if (fin > alineado + bytes) {
+            munmap(reinterpret_cast<void*>(alineado + bytes), fin - (alineado + bytes));
+        }
+        return reinterpret_cast<void*>(alineado);
+    }
+};
+
+// Devuelve a la arena, al salir del ámbito, todo lo reservado dentro de él
+class AmbitoArena {
+public:
+    explicit AmbitoArena(Arena& arena) : arena(arena), inicio(arena.marca()) {}
+    ~AmbitoArena() { arena.volverA(inicio); }
+
+    AmbitoArena(const AmbitoArena&) = delete;
+    AmbitoArena& operator=(const AmbitoArena&) = delete;
+
+private:
+    Arena& arena;
+    Arena::Marca inicio;
+};
+
+// Arena de cada hilo para las versiones que no reciben una: la primera
+// llamada la hace crecer y las siguientes reutilizan sus bloques en lugar de
+// mapear y pre-tocar memoria nueva en cada llamada
+inline Arena& arenaDelHilo() {
+    thread_local Arena arena;
+    return arena;
+}
+
+#endif // ARENA_H
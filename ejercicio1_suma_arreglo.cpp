@@ -9,6 +9,14 @@
 #include <omp.h>
 #endif
 #include <iomanip>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <cmath>
+
+#include "arena.h"
+#include "traza.h"
+#include "indice_sumas.h"
 
 // Estructura para pasar datos a los hilos pthread
 struct ThreadData {
@@ -34,6 +42,7 @@ std::vector<int> generarArreglo(size_t size) {
 // Función que ejecuta cada hilo pthread
 void* sumaParcial(void* arg) {
     ThreadData* data = static_cast<ThreadData*>(arg);
+    AmbitoTraza traza("suma:trozo", data->end - data->start);
     data->partial_sum = 0;
     
     for (size_t i = data->start; i < data->end; ++i) {
@@ -45,6 +54,7 @@ void* sumaParcial(void* arg) {
 
 // Versión secuencial
 long long sumaSecuencial(const std::vector<int>& array) {
+    AmbitoTraza traza("suma:secuencial", array.size());
     long long sum = 0;
     for (int value : array) {
         sum += value;
@@ -52,25 +62,33 @@ long long sumaSecuencial(const std::vector<int>& array) {
     return sum;
 }
 
-// Versión con pthread
-long long sumaPthread(const std::vector<int>& array, int num_threads) {
-    std::vector<pthread_t> threads(num_threads);
-    std::vector<ThreadData> thread_data(num_threads);
+// Versión con pthread. Los descriptores de hilo salen de la arena, así que
+// las llamadas repetidas no reservan memoria.
+long long sumaPthread(const std::vector<int>& array, int num_threads, Arena& arena) {
+    AmbitoArena ambito(arena);
+    pthread_t* threads = arena.reservar<pthread_t>(num_threads);
+    ThreadData* thread_data = arena.reservar<ThreadData>(num_threads);
     
     size_t chunk_size = array.size() / num_threads;
     
     // Crear y lanzar hilos
-    for (int i = 0; i < num_threads; ++i) {
-        thread_data[i].array = &array;
-        thread_data[i].start = i * chunk_size;
-        thread_data[i].end = (i == num_threads - 1) ? array.size() : (i + 1) * chunk_size;
-        
-        pthread_create(&threads[i], nullptr, sumaParcial, &thread_data[i]);
+    {
+        AmbitoTraza traza("suma:crear hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            thread_data[i].array = &array;
+            thread_data[i].start = i * chunk_size;
+            thread_data[i].end = (i == num_threads - 1) ? array.size() : (i + 1) * chunk_size;
+            
+            pthread_create(&threads[i], nullptr, sumaParcial, &thread_data[i]);
+        }
     }
     
     // Esperar a que todos los hilos terminen
-    for (int i = 0; i < num_threads; ++i) {
-        pthread_join(threads[i], nullptr);
+    {
+        AmbitoTraza traza("suma:unir hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            pthread_join(threads[i], nullptr);
+        }
     }
     
     // Sumar resultados parciales
@@ -82,18 +100,443 @@ long long sumaPthread(const std::vector<int>& array, int num_threads) {
     return total_sum;
 }
 
+long long sumaPthread(const std::vector<int>& array, int num_threads) {
+    Arena& arena = arenaDelHilo();
+    return sumaPthread(array, num_threads, arena);
+}
+
 // Versión con OpenMP
 long long sumaOpenMP(const std::vector<int>& array) {
     long long sum = 0;
     
+    // El reparto y la barrera final se separan para que la traza muestre
+    // cuánto espera cada hilo a los demás
+    #pragma omp parallel
+    {
+        {
+            AmbitoTraza traza("suma:trozo OpenMP");
+            #pragma omp for reduction(+:sum) nowait
+            for (size_t i = 0; i < array.size(); ++i) {
+                sum += array[i];
+            }
+        }
+        AmbitoTraza traza("suma:barrera OpenMP");
+        #pragma omp barrier
+    }
+    
+    return sum;
+}
+
+// ============================================================================
+// ESTADÍSTICAS EN UNA SOLA PASADA
+// ============================================================================
+
+const int NUM_CUBETAS_HISTOGRAMA = 10;
+
+// Bloque de 8 KB de int: los contadores del histograma de un bloque caben
+// en 32 bits y sus parciales se combinan con la fórmula de Chan
+const size_t TAM_BLOQUE_ESTADISTICAS = 2048;
+
+// Reparte [minimo, maximo] en cubetas de igual ancho; los valores fuera del
+// rango cuentan en la primera o en la última. La cubeta c empieza en el
+// menor valor con (valor - minimo) * NUM / ancho >= c, es decir, justo por
+// encima de umbrales[c - 1]. Cada valor se compara sin saltos con todos los
+// umbrales y cada umbral lleva su contador de valores que lo superan: son
+// comparaciones SIMD de 32 bits en lugar de una división y un incremento
+// disperso por valor. Los umbrales de cubetas que empiezan más allá de
+// `maximo` valen INT_MAX, que ningún valor supera (ni siquiera los que
+// se recortan a la última cubeta).
+struct ParametrosHistograma {
+    int minimo;
+    int maximo;
+    long long ancho;
+    int umbrales[NUM_CUBETAS_HISTOGRAMA - 1];
+};
+
+ParametrosHistograma crearParametrosHistograma(int minimo, int maximo) {
+    ParametrosHistograma p;
+    p.minimo = minimo;
+    p.maximo = maximo;
+    p.ancho = static_cast<long long>(maximo) - minimo + 1;
+    for (int c = 1; c < NUM_CUBETAS_HISTOGRAMA; ++c) {
+        long long inicio = minimo + (c * p.ancho + NUM_CUBETAS_HISTOGRAMA - 1) / NUM_CUBETAS_HISTOGRAMA;
+        p.umbrales[c - 1] = inicio > maximo ? std::numeric_limits<int>::max() : static_cast<int>(inicio - 1);
+    }
+    return p;
+}
+
+// Resultado (o parcial) de las estadísticas. La suma es exacta; m2 es la
+// suma de cuadrados de las desviaciones respecto de la media, que se combina
+// entre parciales con la fórmula de Chan en lugar de restar sumas de
+// cuadrados grandes.
+// Alineada a la línea de caché: los backends guardan un parcial por hilo en
+// un arreglo contiguo, como ParcialEscaneo en escaneo_paralelo.h.
+struct alignas(64) Estadisticas {
+    size_t cantidad = 0;
+    long long suma = 0;
+    double m2 = 0.0;
+    int minimo = std::numeric_limits<int>::max();
+    int maximo = std::numeric_limits<int>::min();
+    size_t histograma[NUM_CUBETAS_HISTOGRAMA] = {};
+    
+    double media() const { return cantidad > 0 ? static_cast<double>(suma) / cantidad : 0.0; }
+    double varianza() const { return cantidad > 0 ? m2 / cantidad : 0.0; } // Poblacional
+};
+
+void combinarEstadisticas(Estadisticas& destino, const Estadisticas& otra) {
+    if (otra.cantidad == 0) return;
+    if (destino.cantidad == 0) {
+        destino = otra;
+        return;
+    }
+    
+    double n_a = static_cast<double>(destino.cantidad);
+    double n_b = static_cast<double>(otra.cantidad);
+    double delta = otra.media() - destino.media();
+    destino.m2 += otra.m2 + delta * delta * n_a * n_b / (n_a + n_b);
+    destino.cantidad += otra.cantidad;
+    destino.suma += otra.suma;
+    destino.minimo = std::min(destino.minimo, otra.minimo);
+    destino.maximo = std::max(destino.maximo, otra.maximo);
+    for (int c = 0; c < NUM_CUBETAS_HISTOGRAMA; ++c) {
+        destino.histograma[c] += otra.histograma[c];
+    }
+}
+
+// Cada cubeta es la diferencia entre los valores que superan su umbral y
+// los que superan el siguiente
+inline void sumarHistograma(size_t cantidad, const uint32_t* superan, size_t* histograma) {
+    histograma[0] += cantidad - superan[0];
+    for (int c = 1; c < NUM_CUBETAS_HISTOGRAMA - 1; ++c) {
+        histograma[c] += superan[c - 1] - superan[c];
+    }
+    histograma[NUM_CUBETAS_HISTOGRAMA - 1] += superan[NUM_CUBETAS_HISTOGRAMA - 2];
+}
+
+// Pasadas sueltas de la versión en varias pasadas; cada una es un bucle
+// SIMD propio sobre todos los datos
+inline void sumaMinMaxBloque(const int* bloque, size_t cantidad, long long& suma, int& minimo, int& maximo) {
+    #pragma omp simd reduction(+:suma) reduction(min:minimo) reduction(max:maximo)
+    for (size_t j = 0; j < cantidad; ++j) {
+        suma += bloque[j];
+        minimo = std::min(minimo, bloque[j]);
+        maximo = std::max(maximo, bloque[j]);
+    }
+}
+
+inline double m2Bloque(const int* bloque, size_t cantidad, double media) {
+    double m2 = 0.0;
+    #pragma omp simd reduction(+:m2)
+    for (size_t j = 0; j < cantidad; ++j) {
+        double d = bloque[j] - media;
+        m2 += d * d;
+    }
+    return m2;
+}
+
+// Núcleo de un bloque en un único bucle SIMD: suma, extremos, suma de
+// cuadrados (CON_MOMENTOS) y los contadores del histograma. La m2 del bloque
+// sale de los cuadrados desplazados por su primer valor (un dato del propio
+// bloque, así que la resta final apenas cancela cifras) y se combina entre
+// bloques con la fórmula de Chan. Los contadores son escalares sueltos y no
+// un arreglo porque GCC no vectoriza una reducción `omp simd` sobre un
+// arreglo; así cada uno vive en un registro vectorial. Sin CON_MOMENTOS sólo
+// se suma el histograma del bloque al de `parcial`.
+static_assert(NUM_CUBETAS_HISTOGRAMA == 10, "resumirBloque lleva un contador por umbral");
+
+template <bool CON_MOMENTOS>
+inline void resumirBloque(const int* bloque, size_t cantidad, const ParametrosHistograma& p, Estadisticas& parcial) {
+    const int u0 = p.umbrales[0], u1 = p.umbrales[1], u2 = p.umbrales[2];
+    const int u3 = p.umbrales[3], u4 = p.umbrales[4], u5 = p.umbrales[5];
+    const int u6 = p.umbrales[6], u7 = p.umbrales[7], u8 = p.umbrales[8];
+    const double desplazamiento = bloque[0];
+    
+    long long suma = 0;
+    int minimo = std::numeric_limits<int>::max();
+    int maximo = std::numeric_limits<int>::min();
+    double cuadrados = 0.0;
+    uint32_t s0 = 0, s1 = 0, s2 = 0, s3 = 0, s4 = 0, s5 = 0, s6 = 0, s7 = 0, s8 = 0;
+    #pragma omp simd reduction(+:suma, cuadrados, s0, s1, s2, s3, s4, s5, s6, s7, s8) \
+                     reduction(min:minimo) reduction(max:maximo)
+    for (size_t j = 0; j < cantidad; ++j) {
+        int valor = bloque[j];
+        if constexpr (CON_MOMENTOS) {
+            suma += valor;
+            minimo = std::min(minimo, valor);
+            maximo = std::max(maximo, valor);
+            double d = valor - desplazamiento;
+            cuadrados += d * d;
+        }
+        s0 += valor > u0;
+        s1 += valor > u1;
+        s2 += valor > u2;
+        s3 += valor > u3;
+        s4 += valor > u4;
+        s5 += valor > u5;
+        s6 += valor > u6;
+        s7 += valor > u7;
+        s8 += valor > u8;
+    }
+    
+    if constexpr (CON_MOMENTOS) {
+        parcial.cantidad = cantidad;
+        parcial.suma = suma;
+        parcial.minimo = minimo;
+        parcial.maximo = maximo;
+        double desvio = static_cast<double>(suma - static_cast<long long>(bloque[0]) * static_cast<long long>(cantidad));
+        parcial.m2 = std::max(0.0, cuadrados - desvio * desvio / cantidad);
+    }
+    const uint32_t superan[NUM_CUBETAS_HISTOGRAMA - 1] = {s0, s1, s2, s3, s4, s5, s6, s7, s8};
+    sumarHistograma(cantidad, superan, parcial.histograma);
+}
+
+// Núcleo común a los tres backends: cada bloque se recorre una sola vez
+void acumularEstadisticas(const int* datos, size_t n, const ParametrosHistograma& p, Estadisticas& e) {
+    for (size_t base = 0; base < n; base += TAM_BLOQUE_ESTADISTICAS) {
+        Estadisticas parcial;
+        resumirBloque<true>(datos + base, std::min(TAM_BLOQUE_ESTADISTICAS, n - base), p, parcial);
+        combinarEstadisticas(e, parcial);
+    }
+}
+
+// Estructura para pasar datos a los hilos pthread de estadísticas
+struct EstadisticasThreadData {
+    const std::vector<int>* array;
+    const ParametrosHistograma* parametros;
+    size_t start;
+    size_t end;
+    Estadisticas parcial;
+};
+
+void* estadisticasParciales(void* arg) {
+    EstadisticasThreadData* data = static_cast<EstadisticasThreadData*>(arg);
+    AmbitoTraza traza("estadisticas:trozo", data->end - data->start);
+    data->parcial = Estadisticas();
+    acumularEstadisticas(data->array->data() + data->start, data->end - data->start,
+                         *data->parametros, data->parcial);
+    return nullptr;
+}
+
+// Versión secuencial
+Estadisticas estadisticasSecuencial(const std::vector<int>& array, const ParametrosHistograma& parametros) {
+    AmbitoTraza traza("estadisticas:secuencial", array.size());
+    Estadisticas e;
+    acumularEstadisticas(array.data(), array.size(), parametros, e);
+    return e;
+}
+
+// Versión con pthread. Los parciales se combinan en orden de hilo, así que
+// el resultado no depende de qué hilo termine antes.
+Estadisticas estadisticasPthread(const std::vector<int>& array, const ParametrosHistograma& parametros,
+                                 int num_threads, Arena& arena) {
+    AmbitoArena ambito(arena);
+    pthread_t* threads = arena.reservar<pthread_t>(num_threads);
+    EstadisticasThreadData* thread_data = arena.reservar<EstadisticasThreadData>(num_threads);
+    
+    size_t chunk_size = array.size() / num_threads;
+    
+    {
+        AmbitoTraza traza("estadisticas:crear hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            thread_data[i].array = &array;
+            thread_data[i].parametros = &parametros;
+            thread_data[i].start = i * chunk_size;
+            thread_data[i].end = (i == num_threads - 1) ? array.size() : (i + 1) * chunk_size;
+            
+            pthread_create(&threads[i], nullptr, estadisticasParciales, &thread_data[i]);
+        }
+    }
+    
+    {
+        AmbitoTraza traza("estadisticas:unir hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            pthread_join(threads[i], nullptr);
+        }
+    }
+    
+    Estadisticas total;
+    for (int i = 0; i < num_threads; ++i) {
+        combinarEstadisticas(total, thread_data[i].parcial);
+    }
+    return total;
+}
+
+Estadisticas estadisticasPthread(const std::vector<int>& array, const ParametrosHistograma& parametros,
+                                 int num_threads) {
+    Arena& arena = arenaDelHilo();
+    return estadisticasPthread(array, parametros, num_threads, arena);
+}
+
+// Versión con OpenMP: reparto estático por bloques y parciales combinados
+// en orden de hilo por el mismo motivo que en pthread
+Estadisticas estadisticasOpenMP(const std::vector<int>& array, const ParametrosHistograma& parametros) {
+    const size_t num_bloques = (array.size() + TAM_BLOQUE_ESTADISTICAS - 1) / TAM_BLOQUE_ESTADISTICAS;
+#ifdef _OPENMP
+    std::vector<Estadisticas> parciales(omp_get_max_threads());
+#else
+    std::vector<Estadisticas> parciales(1);
+#endif
+    
+    #pragma omp parallel
+    {
+#ifdef _OPENMP
+        Estadisticas& parcial = parciales[omp_get_thread_num()];
+#else
+        Estadisticas& parcial = parciales[0];
+#endif
+        AmbitoTraza traza("estadisticas:trozo OpenMP");
+        #pragma omp for schedule(static)
+        for (size_t b = 0; b < num_bloques; ++b) {
+            size_t base = b * TAM_BLOQUE_ESTADISTICAS;
+            acumularEstadisticas(array.data() + base, std::min(TAM_BLOQUE_ESTADISTICAS, array.size() - base),
+                                 parametros, parcial);
+        }
+    }
+    
+    Estadisticas total;
+    for (const Estadisticas& parcial : parciales) {
+        combinarEstadisticas(total, parcial);
+    }
+    return total;
+}
+
+// Lo que se hacía antes de fusionar: una pasada secuencial por estadística
+// (suma, extremos, m2 respecto de la media global e histograma), cada una
+// con bucles SIMD y el histograma con el mismo conteo por umbrales que la
+// versión fusionada, que se compara con ésta
+Estadisticas estadisticasVariasPasadas(const std::vector<int>& array, const ParametrosHistograma& parametros) {
+    AmbitoTraza traza("estadisticas:varias pasadas", array.size());
+    const int* datos = array.data();
+    const size_t n = array.size();
+    
+    Estadisticas e;
+    e.cantidad = n;
+    e.suma = sumaSecuencial(array);
+    
+    long long suma_descartada = 0;
+    sumaMinMaxBloque(datos, n, suma_descartada, e.minimo, e.maximo);
+    
+    e.m2 = m2Bloque(datos, n, e.media());
+    
+    for (size_t base = 0; base < n; base += TAM_BLOQUE_ESTADISTICAS) {
+        resumirBloque<false>(datos + base, std::min(TAM_BLOQUE_ESTADISTICAS, n - base), parametros, e);
+    }
+    return e;
+}
+
+// Referencia para la verificación, sin medir: m2 en long double respecto de
+// la media global e histograma con la división directa
+Estadisticas estadisticasReferencia(const std::vector<int>& array, const ParametrosHistograma& parametros) {
+    Estadisticas e;
+    e.cantidad = array.size();
+    for (int valor : array) {
+        e.suma += valor;
+        e.minimo = std::min(e.minimo, valor);
+        e.maximo = std::max(e.maximo, valor);
+    }
+    
+    long double media = static_cast<long double>(e.suma) / e.cantidad;
+    long double m2 = 0.0L;
+    for (int valor : array) {
+        long double d = valor - media;
+        m2 += d * d;
+    }
+    e.m2 = static_cast<double>(m2);
+    
+    for (int valor : array) {
+        long long x = static_cast<long long>(std::clamp(valor, parametros.minimo, parametros.maximo)) - parametros.minimo;
+        e.histograma[x * NUM_CUBETAS_HISTOGRAMA / parametros.ancho]++;
+    }
+    return e;
+}
+
+bool estadisticasIguales(const Estadisticas& a, const Estadisticas& b) {
+    bool iguales = a.cantidad == b.cantidad && a.suma == b.suma && a.minimo == b.minimo && a.maximo == b.maximo;
+    for (int c = 0; c < NUM_CUBETAS_HISTOGRAMA; ++c) {
+        iguales = iguales && a.histograma[c] == b.histograma[c];
+    }
+    return iguales && std::abs(a.m2 - b.m2) <= 1e-9 * std::max(std::abs(b.m2), 1.0);
+}
+
+// Suma de [inicio, fin) reescaneando el arreglo, como sumaOpenMP
+long long sumaRangoOpenMP(const std::vector<int>& array, size_t inicio, size_t fin) {
+    long long sum = 0;
+    
     #pragma omp parallel for reduction(+:sum)
-    for (size_t i = 0; i < array.size(); ++i) {
+    for (size_t i = inicio; i < fin; ++i) {
         sum += array[i];
     }
     
     return sum;
 }
 
+// Lote aleatorio: la mitad actualizaciones puntuales y la otra mitad rangos
+// de hasta 1000 elementos; las consultas son rangos arbitrarios
+void generarLote(size_t n, size_t num_actualizaciones, size_t num_consultas, std::mt19937& gen,
+                 std::vector<ActualizacionRango>& actualizaciones, std::vector<ConsultaRango>& consultas) {
+    std::uniform_int_distribution<size_t> posicion(0, n - 1);
+    std::uniform_int_distribution<size_t> longitud(1, 1000);
+    std::uniform_int_distribution<int> delta(-5, 5);
+    
+    actualizaciones.resize(num_actualizaciones);
+    for (size_t k = 0; k < num_actualizaciones; ++k) {
+        size_t inicio = posicion(gen);
+        size_t fin = (k % 2 == 0) ? inicio + 1 : std::min(n, inicio + longitud(gen));
+        actualizaciones[k] = {inicio, fin, delta(gen)};
+    }
+    
+    consultas.resize(num_consultas);
+    for (size_t k = 0; k < num_consultas; ++k) {
+        size_t a = posicion(gen);
+        size_t b = posicion(gen) + 1;
+        consultas[k] = {std::min(a, b), std::max(a, b)};
+    }
+}
+
+// Una ronda de actualizaciones seguida de consultas, con el índice y sin él:
+// aplicar el lote al arreglo y volver a recorrerlo entero con sumaOpenMP,
+// como haría el programa original para tener la suma al día. Las consultas
+// de rango se verifican reescaneando sólo sus rangos, fuera de la medición.
+// Devuelve si las respuestas coinciden.
+bool compararIndice(std::vector<int>& array, IndiceSumas& indice, size_t num_actualizaciones,
+                    int num_threads, Arena& arena, std::mt19937& gen) {
+    const size_t NUM_CONSULTAS = 8;
+    std::vector<ActualizacionRango> actualizaciones;
+    std::vector<ConsultaRango> consultas;
+    generarLote(array.size(), num_actualizaciones, NUM_CONSULTAS, gen, actualizaciones, consultas);
+    std::vector<long long> respuestas_indice(NUM_CONSULTAS);
+    std::vector<long long> respuestas_reescaneo(NUM_CONSULTAS);
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    indice.actualizarLote(actualizaciones.data(), actualizaciones.size(), num_threads, arena);
+    indice.consultarLote(consultas.data(), consultas.size(), respuestas_indice.data(), num_threads, arena);
+    long long total_indice = indice.total();
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms_indice = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    start = std::chrono::high_resolution_clock::now();
+    for (const ActualizacionRango& a : actualizaciones) {
+        for (size_t i = a.inicio; i < a.fin; ++i) {
+            array[i] += a.delta;
+        }
+    }
+    long long total_reescaneo = sumaOpenMP(array);
+    end = std::chrono::high_resolution_clock::now();
+    double ms_reescaneo = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    for (size_t k = 0; k < NUM_CONSULTAS; ++k) {
+        respuestas_reescaneo[k] = sumaRangoOpenMP(array, consultas[k].inicio, consultas[k].fin);
+    }
+    
+    bool correcto = total_indice == total_reescaneo && respuestas_indice == respuestas_reescaneo;
+    std::cout << std::setw(16) << num_actualizaciones
+              << std::setw(14) << ms_indice
+              << std::setw(16) << ms_reescaneo
+              << std::setw(11) << ms_reescaneo / ms_indice << "x"
+              << "  " << (correcto ? "✓" : "✗") << std::endl;
+    return correcto;
+}
+
 int main() {
     const size_t ARRAY_SIZE = 100000000; // 100 millones de elementos
     const int NUM_THREADS = 8;
@@ -186,5 +629,103 @@ int main() {
     std::cout << "Eficiencia pthread: " << (eficiencia_pthread * 100) << "%" << std::endl;
     std::cout << "Eficiencia OpenMP:  " << (eficiencia_openmp * 100) << "%" << std::endl;
     
+    // Llamadas repetidas: la arena se calienta en la primera y las demás
+    // reutilizan sus descriptores de hilo
+    const int REPETICIONES = 10;
+    Arena arena;
+    long long suma_arena = sumaPthread(array, NUM_THREADS, arena);
+    size_t bloques = arena.numBloques();
+    start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < REPETICIONES; ++r) {
+        suma_arena = sumaPthread(array, NUM_THREADS, arena);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double ms_arena = std::chrono::duration<double, std::milli>(end - start).count() / REPETICIONES;
+    
+    std::cout << std::endl;
+    std::cout << "=== REUTILIZACIÓN DE MEMORIA ===" << std::endl;
+    std::cout << "pthread con arena (" << REPETICIONES << " llamadas): " << ms_arena << " ms por llamada" << std::endl;
+    std::cout << "Bloques de la arena estables: " << (arena.numBloques() == bloques ? "✓" : "✗") << std::endl;
+    std::cout << "Resultado con arena correcto: " << (suma_arena == resultado_secuencial ? "✓" : "✗") << std::endl;
+    
+    // Estadísticas: media, varianza, extremos e histograma del mismo arreglo
+    // en una sola pasada, frente a una pasada por estadística
+    std::cout << std::endl;
+    std::cout << "=== ESTADÍSTICAS EN UNA SOLA PASADA ===" << std::endl;
+    ParametrosHistograma parametros = crearParametrosHistograma(1, 1000);
+    Estadisticas referencia = estadisticasReferencia(array, parametros);
+    
+    // Cota inferior: una sola pasada de suma sobre el mismo arreglo
+    start = std::chrono::high_resolution_clock::now();
+    long long suma_pasada = sumaSecuencial(array);
+    end = std::chrono::high_resolution_clock::now();
+    double ms_una_pasada = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    start = std::chrono::high_resolution_clock::now();
+    Estadisticas est_varias = estadisticasVariasPasadas(array, parametros);
+    end = std::chrono::high_resolution_clock::now();
+    double ms_varias = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    start = std::chrono::high_resolution_clock::now();
+    Estadisticas est_secuencial = estadisticasSecuencial(array, parametros);
+    end = std::chrono::high_resolution_clock::now();
+    double ms_est_secuencial = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    start = std::chrono::high_resolution_clock::now();
+    Estadisticas est_pthread = estadisticasPthread(array, parametros, NUM_THREADS, arena);
+    end = std::chrono::high_resolution_clock::now();
+    double ms_est_pthread = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    start = std::chrono::high_resolution_clock::now();
+    Estadisticas est_openmp = estadisticasOpenMP(array, parametros);
+    end = std::chrono::high_resolution_clock::now();
+    double ms_est_openmp = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    std::cout << "Media:    " << referencia.media() << std::endl;
+    std::cout << "Varianza: " << referencia.varianza()
+              << " (desviación " << std::sqrt(referencia.varianza()) << ")" << std::endl;
+    std::cout << "Mínimo:   " << referencia.minimo << "   Máximo: " << referencia.maximo << std::endl;
+    std::cout << "Histograma:" << std::endl;
+    for (int c = 0; c < NUM_CUBETAS_HISTOGRAMA; ++c) {
+        long long desde = parametros.minimo + static_cast<long long>(c) * parametros.ancho / NUM_CUBETAS_HISTOGRAMA;
+        long long hasta = parametros.minimo + static_cast<long long>(c + 1) * parametros.ancho / NUM_CUBETAS_HISTOGRAMA - 1;
+        std::cout << "  [" << std::setw(4) << desde << ", " << std::setw(4) << hasta << "]: "
+                  << referencia.histograma[c] << std::endl;
+    }
+    std::cout << std::endl;
+    std::cout << "Una pasada de suma:   " << ms_una_pasada << " ms  "
+              << (suma_pasada == referencia.suma ? "✓" : "✗") << std::endl;
+    std::cout << "Varias pasadas:       " << ms_varias << " ms  "
+              << (estadisticasIguales(est_varias, referencia) ? "✓" : "✗") << std::endl;
+    std::cout << "Fusionado secuencial: " << ms_est_secuencial << " ms  "
+              << (estadisticasIguales(est_secuencial, referencia) ? "✓" : "✗") << std::endl;
+    std::cout << "Fusionado pthread:    " << ms_est_pthread << " ms  "
+              << (estadisticasIguales(est_pthread, referencia) ? "✓" : "✗") << std::endl;
+    std::cout << "Fusionado OpenMP:     " << ms_est_openmp << " ms  "
+              << (estadisticasIguales(est_openmp, referencia) ? "✓" : "✗") << std::endl;
+    std::cout << "Fusionado secuencial / una pasada de suma: " << ms_est_secuencial / ms_una_pasada << "x" << std::endl;
+    std::cout << "Varias pasadas / fusionado secuencial:     " << ms_varias / ms_est_secuencial << "x" << std::endl;
+    
+    // Índice incremental: el arreglo cambia un poco entre consultas y el
+    // índice evita reescanearlo entero. Las rondas modifican `array`.
+    std::cout << std::endl;
+    std::cout << "=== ÍNDICE INCREMENTAL DE SUMAS ===" << std::endl;
+    start = std::chrono::high_resolution_clock::now();
+    IndiceSumas indice(array);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "Construcción del índice: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+    std::cout << "Total del índice correcto: " << (indice.total() == resultado_secuencial ? "✓" : "✗") << std::endl;
+    std::cout << std::endl;
+    std::cout << "Actualizaciones   Índice (ms)  Reescaneo (ms)    Speedup" << std::endl;
+    
+    std::mt19937 gen(12345);
+    bool indice_correcto = true;
+    for (size_t num_actualizaciones : {10, 1000, 100000, 1000000}) {
+        indice_correcto &= compararIndice(array, indice, num_actualizaciones, NUM_THREADS, arena, gen);
+    }
+    std::cout << "Índice y arreglo coinciden tras las rondas: "
+              << (indice_correcto && indice.total() == sumaOpenMP(array) ? "✓" : "✗") << std::endl;
+    
     return 0;
 }
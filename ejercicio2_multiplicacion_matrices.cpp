@@ -5,12 +5,18 @@
 #include <pthread.h>
 #include <omp.h>
 #include <iomanip>
+#include <algorithm>
 
-// Estructura para pasar datos a los hilos pthread
+#include "arena.h"
+#include "traza.h"
+
+// Estructura para pasar datos a los hilos pthread. Salida es la matriz
+// resultado: vector<vector<int>> o VistaMatriz<int> sobre una Arena.
+template <typename Salida>
 struct MatrixThreadData {
     const std::vector<std::vector<int>>* matrix_a;
     const std::vector<std::vector<int>>* matrix_b;
-    std::vector<std::vector<int>>* matrix_c;
+    Salida* matrix_c;
     int start_row;
     int end_row;
     int n, m, p;
@@ -55,8 +61,10 @@ void imprimirMatriz(const std::vector<std::vector<int>>& matrix, const std::stri
 }
 
 // Función que ejecuta cada hilo pthread para multiplicación de matrices
+template <typename Salida>
 void* multiplicarFilas(void* arg) {
-    MatrixThreadData* data = static_cast<MatrixThreadData*>(arg);
+    MatrixThreadData<Salida>* data = static_cast<MatrixThreadData<Salida>*>(arg);
+    AmbitoTraza traza("matmul:filas", data->end_row - data->start_row);
     
     // Cada hilo calcula las filas asignadas de la matriz resultado
     for (int i = data->start_row; i < data->end_row; ++i) {
@@ -71,87 +79,132 @@ void* multiplicarFilas(void* arg) {
     return nullptr;
 }
 
-// Versión secuencial de multiplicación de matrices
-std::vector<std::vector<int>> multiplicarMatricesSecuencial(
+// Versión secuencial de multiplicación de matrices. C ya tiene n x p
+// elementos y se sobrescribe, así que se puede reutilizar entre llamadas.
+template <typename Salida>
+void multiplicarMatricesSecuencial(
     const std::vector<std::vector<int>>& A,
-    const std::vector<std::vector<int>>& B) {
+    const std::vector<std::vector<int>>& B,
+    Salida& C) {
     
     int n = A.size();
     int m = A[0].size();
     int p = B[0].size();
     
-    std::vector<std::vector<int>> C(n, std::vector<int>(p, 0));
-    
+    AmbitoTraza traza("matmul:secuencial", n);
     for (int i = 0; i < n; ++i) {
         for (int j = 0; j < p; ++j) {
+            C[i][j] = 0;
             for (int k = 0; k < m; ++k) {
                 C[i][j] += A[i][k] * B[k][j];
             }
         }
     }
+}
+
+std::vector<std::vector<int>> multiplicarMatricesSecuencial(
+    const std::vector<std::vector<int>>& A,
+    const std::vector<std::vector<int>>& B) {
     
+    std::vector<std::vector<int>> C(A.size(), std::vector<int>(B[0].size(), 0));
+    multiplicarMatricesSecuencial(A, B, C);
     return C;
 }
 
-// Versión con pthread
-std::vector<std::vector<int>> multiplicarMatricesPthread(
+// Versión con pthread. C ya tiene n x p elementos y los descriptores de
+// hilo salen de la arena, así que las llamadas repetidas no reservan memoria.
+template <typename Salida>
+void multiplicarMatricesPthread(
     const std::vector<std::vector<int>>& A,
     const std::vector<std::vector<int>>& B,
-    int num_threads) {
+    Salida& C,
+    int num_threads,
+    Arena& arena) {
     
     int n = A.size();
     int m = A[0].size();
     int p = B[0].size();
     
-    std::vector<std::vector<int>> C(n, std::vector<int>(p, 0));
-    std::vector<pthread_t> threads(num_threads);
-    std::vector<MatrixThreadData> thread_data(num_threads);
+    AmbitoArena ambito(arena);
+    pthread_t* threads = arena.reservar<pthread_t>(num_threads);
+    MatrixThreadData<Salida>* thread_data = arena.reservar<MatrixThreadData<Salida>>(num_threads);
     
     int chunk_size = n / num_threads;
     
     // Crear y lanzar hilos
-    for (int i = 0; i < num_threads; ++i) {
-        thread_data[i].matrix_a = &A;
-        thread_data[i].matrix_b = &B;
-        thread_data[i].matrix_c = &C;
-        thread_data[i].start_row = i * chunk_size;
-        thread_data[i].end_row = (i == num_threads - 1) ? n : (i + 1) * chunk_size;
-        thread_data[i].n = n;
-        thread_data[i].m = m;
-        thread_data[i].p = p;
-        
-        pthread_create(&threads[i], nullptr, multiplicarFilas, &thread_data[i]);
+    {
+        AmbitoTraza traza("matmul:crear hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            thread_data[i].matrix_a = &A;
+            thread_data[i].matrix_b = &B;
+            thread_data[i].matrix_c = &C;
+            thread_data[i].start_row = i * chunk_size;
+            thread_data[i].end_row = (i == num_threads - 1) ? n : (i + 1) * chunk_size;
+            thread_data[i].n = n;
+            thread_data[i].m = m;
+            thread_data[i].p = p;
+            
+            pthread_create(&threads[i], nullptr, multiplicarFilas<Salida>, &thread_data[i]);
+        }
     }
     
     // Esperar a que todos los hilos terminen
-    for (int i = 0; i < num_threads; ++i) {
-        pthread_join(threads[i], nullptr);
+    {
+        AmbitoTraza traza("matmul:unir hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            pthread_join(threads[i], nullptr);
+        }
     }
+}
+
+std::vector<std::vector<int>> multiplicarMatricesPthread(
+    const std::vector<std::vector<int>>& A,
+    const std::vector<std::vector<int>>& B,
+    int num_threads) {
     
+    std::vector<std::vector<int>> C(A.size(), std::vector<int>(B[0].size(), 0));
+    Arena& arena = arenaDelHilo();
+    multiplicarMatricesPthread(A, B, C, num_threads, arena);
     return C;
 }
 
-// Versión con OpenMP
-std::vector<std::vector<int>> multiplicarMatricesOpenMP(
+// Versión con OpenMP. C ya tiene n x p elementos y se sobrescribe.
+template <typename Salida>
+void multiplicarMatricesOpenMP(
     const std::vector<std::vector<int>>& A,
-    const std::vector<std::vector<int>>& B) {
+    const std::vector<std::vector<int>>& B,
+    Salida& C) {
     
     int n = A.size();
     int m = A[0].size();
     int p = B[0].size();
     
-    std::vector<std::vector<int>> C(n, std::vector<int>(p, 0));
-    
-    #pragma omp parallel for collapse(2)
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < p; ++j) {
-            C[i][j] = 0;
-            for (int k = 0; k < m; ++k) {
-                C[i][j] += A[i][k] * B[k][j];
+    // La barrera implícita del for se hace explícita para trazar la espera
+    #pragma omp parallel
+    {
+        {
+            AmbitoTraza traza("matmul:trozo OpenMP");
+            #pragma omp for collapse(2) nowait
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < p; ++j) {
+                    C[i][j] = 0;
+                    for (int k = 0; k < m; ++k) {
+                        C[i][j] += A[i][k] * B[k][j];
+                    }
+                }
             }
         }
+        AmbitoTraza traza("matmul:barrera OpenMP");
+        #pragma omp barrier
     }
+}
+
+std::vector<std::vector<int>> multiplicarMatricesOpenMP(
+    const std::vector<std::vector<int>>& A,
+    const std::vector<std::vector<int>>& B) {
     
+    std::vector<std::vector<int>> C(A.size(), std::vector<int>(B[0].size(), 0));
+    multiplicarMatricesOpenMP(A, B, C);
     return C;
 }
 
@@ -171,6 +224,39 @@ bool matricesIguales(const std::vector<std::vector<int>>& A, const std::vector<s
     return true;
 }
 
+// Compara R llamadas que devuelven una matriz nueva con R llamadas que
+// escriben en la misma VistaMatriz de una arena
+template <typename Asignando, typename ConArena>
+void medirReutilizacion(const char* nombre, int repeticiones, Arena& arena,
+                        const std::vector<std::vector<int>>& referencia, VistaMatriz<int>& C,
+                        Asignando llamarAsignando, ConArena llamarConArena) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < repeticiones; ++r) {
+        llamarAsignando();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms_asignando = std::chrono::duration<double, std::milli>(end - start).count() / repeticiones;
+    
+    llamarConArena(); // Calienta la arena
+    size_t bloques = arena.numBloques();
+    start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < repeticiones; ++r) {
+        llamarConArena();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double ms_arena = std::chrono::duration<double, std::milli>(end - start).count() / repeticiones;
+    
+    bool correcto = true;
+    for (size_t i = 0; i < C.filas && correcto; ++i) {
+        correcto = std::equal(referencia[i].begin(), referencia[i].end(), C[i]);
+    }
+    
+    std::cout << std::left << std::setw(12) << nombre << std::right << std::fixed << std::setprecision(2)
+              << std::setw(14) << ms_asignando << std::setw(10) << ms_arena
+              << "  " << (arena.numBloques() == bloques ? "sí" : "no")
+              << "  " << (correcto ? "✓" : "✗") << std::endl;
+}
+
 int main() {
     const int N = 1000; // Filas de matriz A
     const int M = 1000; // Columnas de matriz A / Filas de matriz B
@@ -285,5 +371,33 @@ int main() {
     std::cout << "Operaciones/sec pthread:    " << ops_sec_pthread << std::endl;
     std::cout << "Operaciones/sec OpenMP:     " << ops_sec_openmp << std::endl;
     
+    // Llamadas repetidas sobre matrices pequeñas, donde el costo de reservar
+    // las n filas del resultado pesa frente al cálculo
+    const int N_REUSO = 200;
+    const int REPETICIONES = 30;
+    auto reuso_a = generarMatriz(N_REUSO, N_REUSO);
+    auto reuso_b = generarMatriz(N_REUSO, N_REUSO);
+    auto referencia = multiplicarMatricesSecuencial(reuso_a, reuso_b);
+    
+    Arena arena;
+    VistaMatriz<int> C = arena.reservarMatriz<int>(N_REUSO, N_REUSO);
+    
+    std::cout << std::endl;
+    std::cout << "=== REUTILIZACIÓN DE MEMORIA ===" << std::endl;
+    std::cout << REPETICIONES << " llamadas con matrices " << N_REUSO << " x " << N_REUSO
+              << " (ms por llamada)" << std::endl;
+    std::cout << std::left << std::setw(12) << "Versión" << std::right << std::setw(14) << "contenedores"
+              << std::setw(10) << "arena" << "  estable" << std::endl;
+    medirReutilizacion("secuencial", REPETICIONES, arena, referencia, C,
+        [&] { multiplicarMatricesSecuencial(reuso_a, reuso_b); },
+        [&] { multiplicarMatricesSecuencial(reuso_a, reuso_b, C); });
+    medirReutilizacion("pthread", REPETICIONES, arena, referencia, C,
+        [&] { multiplicarMatricesPthread(reuso_a, reuso_b, NUM_THREADS); },
+        [&] { multiplicarMatricesPthread(reuso_a, reuso_b, C, NUM_THREADS, arena); });
+    medirReutilizacion("OpenMP", REPETICIONES, arena, referencia, C,
+        [&] { multiplicarMatricesOpenMP(reuso_a, reuso_b); },
+        [&] { multiplicarMatricesOpenMP(reuso_a, reuso_b, C); });
+    std::cout << "Arena: " << arena.bytesMapeados() / 1024 << " KB en " << arena.numBloques() << " bloques" << std::endl;
+    
     return 0;
 }
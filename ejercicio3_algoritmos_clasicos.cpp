@@ -1,6 +1,8 @@
 #include <iostream>
 #include <vector>
-#include <queue>
+#include <array>
+#include <memory>
+#include <new>
 #include <random>
 #include <chrono>
 #include <pthread.h>
@@ -10,80 +12,328 @@
 #include <mutex>
 #include <condition_variable>
 #include <thread>
+#include <atomic>
+#include <map>
+#include <string>
+#include <sstream>
+#include <functional>
+#include <coroutine>
+#include <deque>
+#include <optional>
+#include <utility>
+#include <exception>
+#include <cmath>
+#include <type_traits>
+#include <limits>
+#include <cstdint>
+#include <tuple>
+#include <stdexcept>
+#include <numeric>
+
+#include "arena.h"
+#include "escaneo_paralelo.h"
+#include "traza.h"
 
 // ============================================================================
 // 1. PROBLEMA PRODUCTOR-CONSUMIDOR
 // ============================================================================
 
+// Buffer acotado genérico. Los elementos se construyen directamente en una
+// ranura de un anillo preasignado y se entregan por movimiento: el buffer
+// nunca copia la carga útil ni reserva memoria después del constructor.
+template <typename T>
 class BufferProductorConsumidor {
 private:
-    std::queue<int> buffer;
+    struct Ranura {
+        alignas(T) unsigned char datos[sizeof(T)];
+        T* elemento() { return reinterpret_cast<T*>(datos); }
+    };
+
+    std::unique_ptr<Ranura[]> ranuras;
+    size_t cabeza;
+    size_t cantidad;
     std::mutex mutex;
     std::condition_variable not_full;
     std::condition_variable not_empty;
     size_t max_size;
     bool done;
 
+    // Toma el mutex; si está ocupado, la espera queda en la traza
+    std::unique_lock<std::mutex> tomarMutex() {
+        std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            AmbitoTraza traza("buffer:espera mutex");
+            lock.lock();
+        }
+        return lock;
+    }
+
+    // Requiere el mutex tomado y espacio libre en el anillo
+    template <typename... Args>
+    void construirEnCola(Args&&... args) {
+        size_t indice = (cabeza + cantidad) % max_size;
+        new (ranuras[indice].datos) T(std::forward<Args>(args)...);
+        ++cantidad;
+    }
+
 public:
-    BufferProductorConsumidor(size_t size) : max_size(size), done(false) {}
-    
-    void producir(int item) {
-        std::unique_lock<std::mutex> lock(mutex);
-        not_full.wait(lock, [this] { return buffer.size() < max_size || done; });
-        
+    BufferProductorConsumidor(size_t size)
+        : ranuras(new Ranura[size]), cabeza(0), cantidad(0), max_size(size), done(false) {}
+
+    ~BufferProductorConsumidor() {
+        for (size_t i = 0; i < cantidad; ++i) {
+            ranuras[(cabeza + i) % max_size].elemento()->~T();
+        }
+    }
+
+    BufferProductorConsumidor(const BufferProductorConsumidor&) = delete;
+    BufferProductorConsumidor& operator=(const BufferProductorConsumidor&) = delete;
+
+    void producir(T&& item) {
+        emplazar(std::move(item));
+    }
+
+    // Construye el elemento en la ranura libre sin objetos temporales
+    template <typename... Args>
+    void emplazar(Args&&... args) {
+        std::unique_lock<std::mutex> lock = tomarMutex();
+        if (cantidad == max_size && !done) {
+            AmbitoTraza traza("buffer:espera lleno");
+            not_full.wait(lock, [this] { return cantidad < max_size || done; });
+        }
+
         if (!done) {
-            buffer.push(item);
+            construirEnCola(std::forward<Args>(args)...);
             not_empty.notify_one();
         }
     }
-    
-    bool consumir(int& item) {
-        std::unique_lock<std::mutex> lock(mutex);
-        not_empty.wait(lock, [this] { return !buffer.empty() || done; });
-        
-        if (buffer.empty() && done) {
+
+    bool consumir(T& item) {
+        std::unique_lock<std::mutex> lock = tomarMutex();
+        if (cantidad == 0 && !done) {
+            AmbitoTraza traza("buffer:espera vacío");
+            not_empty.wait(lock, [this] { return cantidad > 0 || done; });
+        }
+
+        if (cantidad == 0 && done) {
             return false;
         }
-        
-        item = buffer.front();
-        buffer.pop();
+
+        T* frente = ranuras[cabeza].elemento();
+        item = std::move(*frente);
+        frente->~T();
+        cabeza = (cabeza + 1) % max_size;
+        --cantidad;
         not_full.notify_one();
         return true;
     }
-    
+
     void terminar() {
         std::unique_lock<std::mutex> lock(mutex);
         done = true;
         not_full.notify_all();
         not_empty.notify_all();
     }
-    
+
     size_t size() const {
         std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(mutex));
-        return buffer.size();
+        return cantidad;
+    }
+};
+
+// Pool de bloques para cargas útiles grandes. La memoria se reserva por slabs
+// de varios bloques y se recicla entre hilos: cada hilo trabaja contra su
+// CacheHilo local y sólo toca la lista global (con mutex) por lotes, de modo
+// que en régimen estacionario no se llama a malloc.
+template <typename T>
+class PoolSlab {
+private:
+    union Nodo {
+        Nodo* siguiente;
+        alignas(T) unsigned char datos[sizeof(T)];
+    };
+
+public:
+    class CacheHilo;
+
+    struct Devolver {
+        PoolSlab* pool;
+        void operator()(T* p) const {
+            p->~T();
+            pool->devolverNodo(reinterpret_cast<Nodo*>(p));
+        }
+    };
+
+    using Puntero = std::unique_ptr<T, Devolver>;
+
+    // Caché de bloques libres de un hilo. Mientras existe, las reservas y
+    // devoluciones de ese hilo sobre el pool no toman el mutex global.
+    class CacheHilo {
+    private:
+        PoolSlab* pool;
+        Nodo* libres;
+        size_t num_libres;
+        CacheHilo* anterior;
+
+        friend class PoolSlab;
+
+    public:
+        explicit CacheHilo(PoolSlab& p)
+            : pool(&p), libres(nullptr), num_libres(0), anterior(cache_actual) {
+            cache_actual = this;
+        }
+
+        ~CacheHilo() {
+            pool->devolverLote(libres, num_libres);
+            cache_actual = anterior;
+        }
+
+        CacheHilo(const CacheHilo&) = delete;
+        CacheHilo& operator=(const CacheHilo&) = delete;
+    };
+
+    explicit PoolSlab(size_t bloques_por_slab = 64, size_t tam_lote = 16)
+        : libres_global(nullptr), bloques_por_slab(bloques_por_slab), tam_lote(tam_lote) {}
+
+    PoolSlab(const PoolSlab&) = delete;
+    PoolSlab& operator=(const PoolSlab&) = delete;
+
+    template <typename... Args>
+    Puntero crear(Args&&... args) {
+        Nodo* nodo = obtenerNodo();
+        T* objeto = new (nodo->datos) T(std::forward<Args>(args)...);
+        return Puntero(objeto, Devolver{this});
+    }
+
+    size_t slabsReservados() const {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(mutex));
+        return slabs.size();
+    }
+
+private:
+    std::mutex mutex;
+    Nodo* libres_global;
+    std::vector<std::unique_ptr<Nodo[]>> slabs;
+    size_t bloques_por_slab;
+    size_t tam_lote;
+
+    static thread_local CacheHilo* cache_actual;
+
+    CacheHilo* cacheLocal() {
+        CacheHilo* cache = cache_actual;
+        return (cache != nullptr && cache->pool == this) ? cache : nullptr;
+    }
+
+    // Requiere el mutex tomado
+    void reservarSlab() {
+        slabs.emplace_back(new Nodo[bloques_por_slab]);
+        Nodo* slab = slabs.back().get();
+        for (size_t i = 0; i < bloques_por_slab; ++i) {
+            slab[i].siguiente = libres_global;
+            libres_global = &slab[i];
+        }
+    }
+
+    // Extrae hasta `maximo` nodos de la lista global; requiere el mutex tomado
+    Nodo* extraerLote(size_t maximo, size_t& extraidos) {
+        if (libres_global == nullptr) {
+            reservarSlab();
+        }
+        Nodo* inicio = libres_global;
+        Nodo* ultimo = inicio;
+        extraidos = 1;
+        while (extraidos < maximo && ultimo->siguiente != nullptr) {
+            ultimo = ultimo->siguiente;
+            ++extraidos;
+        }
+        libres_global = ultimo->siguiente;
+        ultimo->siguiente = nullptr;
+        return inicio;
+    }
+
+    Nodo* obtenerNodo() {
+        CacheHilo* cache = cacheLocal();
+        if (cache == nullptr) {
+            std::lock_guard<std::mutex> lock(mutex);
+            size_t extraidos;
+            return extraerLote(1, extraidos);
+        }
+
+        if (cache->libres == nullptr) {
+            std::lock_guard<std::mutex> lock(mutex);
+            cache->libres = extraerLote(tam_lote, cache->num_libres);
+        }
+        Nodo* nodo = cache->libres;
+        cache->libres = nodo->siguiente;
+        --cache->num_libres;
+        return nodo;
+    }
+
+    void devolverNodo(Nodo* nodo) {
+        CacheHilo* cache = cacheLocal();
+        if (cache == nullptr) {
+            nodo->siguiente = nullptr;
+            devolverLote(nodo, 1);
+            return;
+        }
+
+        nodo->siguiente = cache->libres;
+        cache->libres = nodo;
+        ++cache->num_libres;
+
+        // Los consumidores acumulan bloques que necesitan los productores:
+        // se devuelve un lote a la lista global cuando la caché crece demasiado
+        if (cache->num_libres >= 2 * tam_lote) {
+            Nodo* ultimo = cache->libres;
+            for (size_t i = 1; i < tam_lote; ++i) {
+                ultimo = ultimo->siguiente;
+            }
+            Nodo* resto = ultimo->siguiente;
+            ultimo->siguiente = nullptr;
+            devolverLote(cache->libres, tam_lote);
+            cache->libres = resto;
+            cache->num_libres -= tam_lote;
+        }
+    }
+
+    void devolverLote(Nodo* inicio, size_t cantidad) {
+        if (inicio == nullptr || cantidad == 0) {
+            return;
+        }
+        Nodo* ultimo = inicio;
+        while (ultimo->siguiente != nullptr) {
+            ultimo = ultimo->siguiente;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        ultimo->siguiente = libres_global;
+        libres_global = inicio;
     }
 };
 
+template <typename T>
+thread_local typename PoolSlab<T>::CacheHilo* PoolSlab<T>::cache_actual = nullptr;
+
 struct ProductorConsumidorData {
-    BufferProductorConsumidor* buffer;
+    BufferProductorConsumidor<int>* buffer;
     int id;
     int num_items;
 };
 
 void* productor(void* arg) {
     ProductorConsumidorData* data = static_cast<ProductorConsumidorData*>(arg);
-    
+    AmbitoTraza traza("pc:productor", data->num_items);
+
     for (int i = 0; i < data->num_items; ++i) {
-        int item = data->id * 1000 + i;
-        data->buffer->producir(item);
+        data->buffer->producir(data->id * 1000 + i);
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
-    
+
     return nullptr;
 }
 
 void* consumidor(void* arg) {
     ProductorConsumidorData* data = static_cast<ProductorConsumidorData*>(arg);
+    AmbitoTraza traza("pc:consumidor");
     
     int item;
     while (data->buffer->consumir(item)) {
@@ -94,439 +344,3990 @@ void* consumidor(void* arg) {
     return nullptr;
 }
 
-void ejecutarProductorConsumidor() {
-    std::cout << "\n=== 1. PROBLEMA PRODUCTOR-CONSUMIDOR ===" << std::endl;
-    
-    const int BUFFER_SIZE = 10;
-    const int NUM_PRODUCTORES = 3;
-    const int NUM_CONSUMIDORES = 2;
-    const int ITEMS_POR_PRODUCTOR = 20;
-    
-    BufferProductorConsumidor buffer(BUFFER_SIZE);
-    std::vector<pthread_t> productores(NUM_PRODUCTORES);
-    std::vector<pthread_t> consumidores(NUM_CONSUMIDORES);
-    std::vector<ProductorConsumidorData> prod_data(NUM_PRODUCTORES);
-    std::vector<ProductorConsumidorData> cons_data(NUM_CONSUMIDORES);
-    
-    // Crear productores
-    for (int i = 0; i < NUM_PRODUCTORES; ++i) {
-        prod_data[i] = {&buffer, i, ITEMS_POR_PRODUCTOR};
-        pthread_create(&productores[i], nullptr, productor, &prod_data[i]);
-    }
-    
-    // Crear consumidores
-    for (int i = 0; i < NUM_CONSUMIDORES; ++i) {
-        cons_data[i] = {&buffer, i, 0};
-        pthread_create(&consumidores[i], nullptr, consumidor, &cons_data[i]);
-    }
-    
-    // Esperar a que los productores terminen
-    for (int i = 0; i < NUM_PRODUCTORES; ++i) {
-        pthread_join(productores[i], nullptr);
-    }
-    
-    // Señalar que no hay más producción
-    buffer.terminar();
-    
-    // Esperar a que los consumidores terminen
-    for (int i = 0; i < NUM_CONSUMIDORES; ++i) {
-        pthread_join(consumidores[i], nullptr);
+// Registro de varios KB que viaja entre etapas. Se construye una sola vez en
+// un bloque del pool y por el buffer sólo circula el puntero propietario.
+struct Registro {
+    int productor;
+    int secuencia;
+    std::array<char, 4096> datos;
+
+    Registro(int productor, int secuencia) : productor(productor), secuencia(secuencia) {
+        datos[0] = static_cast<char>(secuencia);
     }
-    
-    std::cout << "Productor-Consumidor completado exitosamente!" << std::endl;
-}
+};
 
-// ============================================================================
-// 2. MULTIPLICACIÓN MATRIZ-VECTOR
-// ============================================================================
+using PunteroRegistro = PoolSlab<Registro>::Puntero;
 
-struct MatrizVectorData {
-    const std::vector<std::vector<int>>* matriz;
-    const std::vector<int>* vector;
-    std::vector<int>* resultado;
-    int start_row;
-    int end_row;
+struct RegistrosData {
+    BufferProductorConsumidor<PunteroRegistro>* buffer;
+    PoolSlab<Registro>* pool;
+    int id;
+    int num_items;
+    long long checksum;
 };
 
-void* multiplicarMatrizVectorParcial(void* arg) {
-    MatrizVectorData* data = static_cast<MatrizVectorData*>(arg);
-    
-    for (int i = data->start_row; i < data->end_row; ++i) {
-        (*data->resultado)[i] = 0;
-        for (size_t j = 0; j < (*data->matriz)[i].size(); ++j) {
-            (*data->resultado)[i] += (*data->matriz)[i][j] * (*data->vector)[j];
-        }
+void* productorRegistros(void* arg) {
+    RegistrosData* data = static_cast<RegistrosData*>(arg);
+    AmbitoTraza traza("pc:productor registros", data->num_items);
+    PoolSlab<Registro>::CacheHilo cache(*data->pool);
+
+    for (int i = 0; i < data->num_items; ++i) {
+        data->buffer->emplazar(data->pool->crear(data->id, i));
     }
-    
+
     return nullptr;
 }
 
-std::vector<int> multiplicarMatrizVectorParalelo(
-    const std::vector<std::vector<int>>& matriz,
-    const std::vector<int>& vector,
-    int num_threads) {
-    
-    int n = matriz.size();
-    std::vector<int> resultado(n, 0);
-    std::vector<pthread_t> threads(num_threads);
-    std::vector<MatrizVectorData> thread_data(num_threads);
-    
-    int chunk_size = n / num_threads;
-    
-    // Crear y lanzar hilos
-    for (int i = 0; i < num_threads; ++i) {
-        thread_data[i].matriz = &matriz;
-        thread_data[i].vector = &vector;
-        thread_data[i].resultado = &resultado;
-        thread_data[i].start_row = i * chunk_size;
-        thread_data[i].end_row = (i == num_threads - 1) ? n : (i + 1) * chunk_size;
-        
-        pthread_create(&threads[i], nullptr, multiplicarMatrizVectorParcial, &thread_data[i]);
-    }
-    
-    // Esperar a que todos los hilos terminen
-    for (int i = 0; i < num_threads; ++i) {
-        pthread_join(threads[i], nullptr);
+void* consumidorRegistros(void* arg) {
+    RegistrosData* data = static_cast<RegistrosData*>(arg);
+    AmbitoTraza traza("pc:consumidor registros");
+    PoolSlab<Registro>::CacheHilo cache(*data->pool);
+
+    data->checksum = 0;
+    PunteroRegistro registro;
+    while (data->buffer->consumir(registro)) {
+        data->checksum += registro->secuencia + registro->datos[0];
+        registro.reset(); // El bloque vuelve a la caché de este hilo
     }
-    
-    return resultado;
+
+    return nullptr;
 }
 
-std::vector<int> multiplicarMatrizVectorSecuencial(
-    const std::vector<std::vector<int>>& matriz,
-    const std::vector<int>& vector) {
-    
-    int n = matriz.size();
-    std::vector<int> resultado(n, 0);
-    
-    for (int i = 0; i < n; ++i) {
-        for (size_t j = 0; j < matriz[i].size(); ++j) {
-            resultado[i] += matriz[i][j] * vector[j];
+// Ejecuta una ronda completa de productores y consumidores de registros y
+// devuelve la suma de verificación acumulada por los consumidores
+long long rondaRegistros(PoolSlab<Registro>& pool, int num_productores,
+                         int num_consumidores, int items_por_productor) {
+    BufferProductorConsumidor<PunteroRegistro> buffer(64);
+    std::vector<pthread_t> productores(num_productores);
+    std::vector<pthread_t> consumidores(num_consumidores);
+    std::vector<RegistrosData> prod_data(num_productores);
+    std::vector<RegistrosData> cons_data(num_consumidores);
+
+    {
+        AmbitoTraza traza("pc:crear hilos", num_productores + num_consumidores);
+        for (int i = 0; i < num_consumidores; ++i) {
+            cons_data[i] = {&buffer, &pool, i, 0, 0};
+            pthread_create(&consumidores[i], nullptr, consumidorRegistros, &cons_data[i]);
         }
-    }
-    
-    return resultado;
-}
 
-void ejecutarMultiplicacionMatrizVector() {
-    std::cout << "\n=== 2. MULTIPLICACIÓN MATRIZ-VECTOR ===" << std::endl;
-    
-    const int N = 2000; // Filas de matriz
-    const int M = 2000; // Columnas de matriz
-    const int NUM_THREADS = 8;
-    
-    // Generar matriz y vector
-    std::vector<std::vector<int>> matriz(N, std::vector<int>(M));
-    std::vector<int> vector(M);
-    
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(1, 100);
-    
-    for (int i = 0; i < N; ++i) {
-        for (int j = 0; j < M; ++j) {
-            matriz[i][j] = dis(gen);
+        for (int i = 0; i < num_productores; ++i) {
+            prod_data[i] = {&buffer, &pool, i, items_por_productor, 0};
+            pthread_create(&productores[i], nullptr, productorRegistros, &prod_data[i]);
         }
     }
-    
-    for (int j = 0; j < M; ++j) {
-        vector[j] = dis(gen);
+
+    for (int i = 0; i < num_productores; ++i) {
+        pthread_join(productores[i], nullptr);
     }
-    
-    std::cout << "Matriz: " << N << " x " << M << std::endl;
-    std::cout << "Vector: " << M << " elementos" << std::endl;
-    
-    // Medir versión secuencial
+
+    buffer.terminar();
+
+    long long checksum = 0;
+    for (int i = 0; i < num_consumidores; ++i) {
+        pthread_join(consumidores[i], nullptr);
+        checksum += cons_data[i].checksum;
+    }
+
+    return checksum;
+}
+
+void ejecutarProductorConsumidorRegistros() {
+    const int NUM_PRODUCTORES = 3;
+    const int NUM_CONSUMIDORES = 2;
+    const int ITEMS_POR_PRODUCTOR = 100000;
+
+    std::cout << "\nTransferencia de registros de " << sizeof(Registro)
+              << " bytes (movidos, sin copia) con pool de slabs" << std::endl;
+
+    PoolSlab<Registro> pool;
+
+    // Ronda de calentamiento: el pool alcanza su tamaño de régimen
+    rondaRegistros(pool, NUM_PRODUCTORES, NUM_CONSUMIDORES, ITEMS_POR_PRODUCTOR / 10);
+    size_t slabs_calentamiento = pool.slabsReservados();
+
     auto start = std::chrono::high_resolution_clock::now();
-    auto resultado_secuencial = multiplicarMatrizVectorSecuencial(matriz, vector);
+    long long checksum = rondaRegistros(pool, NUM_PRODUCTORES, NUM_CONSUMIDORES, ITEMS_POR_PRODUCTOR);
     auto end = std::chrono::high_resolution_clock::now();
-    auto tiempo_secuencial = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-    
-    // Medir versión paralela
-    start = std::chrono::high_resolution_clock::now();
-    auto resultado_paralelo = multiplicarMatrizVectorParalelo(matriz, vector, NUM_THREADS);
-    end = std::chrono::high_resolution_clock::now();
-    auto tiempo_paralelo = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-    
-    // Verificar resultados
-    bool correcto = (resultado_secuencial == resultado_paralelo);
-    std::cout << "Resultado correcto: " << (correcto ? "✓" : "✗") << std::endl;
-    
-    // Análisis de rendimiento
-    double speedup = static_cast<double>(tiempo_secuencial.count()) / tiempo_paralelo.count();
-    double eficiencia = speedup / NUM_THREADS;
-    
-    std::cout << "Tiempo secuencial: " << tiempo_secuencial.count() << " ms" << std::endl;
-    std::cout << "Tiempo paralelo:   " << tiempo_paralelo.count() << " ms" << std::endl;
-    std::cout << "Speedup: " << speedup << "x" << std::endl;
-    std::cout << "Eficiencia: " << (eficiencia * 100) << "%" << std::endl;
-}
+    auto tiempo = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 
-// ============================================================================
-// 3. REGLA TRAPEZOIDAL (INTEGRACIÓN NUMÉRICA)
-// ============================================================================
+    long long esperado = 0;
+    for (int p = 0; p < NUM_PRODUCTORES; ++p) {
+        for (int i = 0; i < ITEMS_POR_PRODUCTOR; ++i) {
+            esperado += i + static_cast<char>(i);
+        }
+    }
 
-double funcion(double x) {
-    return x * x; // f(x) = x²
+    long long total_items = static_cast<long long>(NUM_PRODUCTORES) * ITEMS_POR_PRODUCTOR;
+    std::cout << "Registros transferidos: " << total_items << std::endl;
+    std::cout << "Resultado correcto: " << (checksum == esperado ? "✓" : "✗") << std::endl;
+    std::cout << "Tiempo: " << tiempo.count() << " ms" << std::endl;
+    std::cout << "Registros/sec: " << std::fixed << std::setprecision(0)
+              << total_items / std::max(tiempo.count() / 1000.0, 1e-3) << std::endl;
+    std::cout << "Slabs reservados tras calentamiento: " << slabs_calentamiento << std::endl;
+    std::cout << "Slabs reservados en régimen:         " << pool.slabsReservados() - slabs_calentamiento << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
 }
 
-double reglaTrapezoidalSecuencial(double a, double b, int n) {
-    double h = (b - a) / n;
-    double suma = 0.5 * (funcion(a) + funcion(b));
-    
-    for (int i = 1; i < n; ++i) {
-        double x = a + i * h;
-        suma += funcion(x);
+// Versión asíncrona con corrutinas de C++20: miles de productores y
+// consumidores lógicos comparten un número fijo de hilos del ejecutor. Una
+// corrutina que no puede avanzar queda aparcada en la lista de espera del
+// buffer, no en una variable de condición del sistema operativo.
+
+class EjecutorCorrutinas;
+
+// Corrutina lanzada en un ejecutor; su marco se libera al terminar
+class Tarea {
+public:
+    struct promise_type {
+        EjecutorCorrutinas* ejecutor = nullptr;
+
+        Tarea get_return_object() {
+            return Tarea(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+        ~promise_type();
+    };
+
+    explicit Tarea(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    Tarea(Tarea&& otra) noexcept : handle(std::exchange(otra.handle, nullptr)) {}
+    Tarea(const Tarea&) = delete;
+    Tarea& operator=(const Tarea&) = delete;
+
+    ~Tarea() {
+        if (handle) {
+            handle.destroy();
+        }
     }
-    
-    return h * suma;
-}
 
-struct TrapezoidalData {
-    double a, b;
-    int n;
-    int start_i, end_i;
-    double partial_sum;
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    friend class EjecutorCorrutinas;
 };
 
-void* reglaTrapezoidalParcial(void* arg) {
-    TrapezoidalData* data = static_cast<TrapezoidalData*>(arg);
-    
-    double h = (data->b - data->a) / data->n;
-    data->partial_sum = 0.0;
-    
-    for (int i = data->start_i; i < data->end_i; ++i) {
-        double x = data->a + i * h;
-        data->partial_sum += funcion(x);
+// Grupo fijo de hilos pthread que reanuda corrutinas listas para ejecutar
+class EjecutorCorrutinas {
+private:
+    std::vector<pthread_t> hilos;
+    std::deque<std::coroutine_handle<>> listas;
+    std::mutex mutex;
+    std::condition_variable hay_trabajo;
+    std::condition_variable sin_tareas;
+    long long tareas_vivas;
+    bool detener;
+
+    static void* hiloEjecutor(void* arg) {
+        EjecutorCorrutinas* ejecutor = static_cast<EjecutorCorrutinas*>(arg);
+
+        while (true) {
+            std::coroutine_handle<> handle;
+            {
+                std::unique_lock<std::mutex> lock(ejecutor->mutex);
+                ejecutor->hay_trabajo.wait(lock, [ejecutor] {
+                    return !ejecutor->listas.empty() || ejecutor->detener;
+                });
+                if (ejecutor->listas.empty()) {
+                    return nullptr;
+                }
+                handle = ejecutor->listas.front();
+                ejecutor->listas.pop_front();
+            }
+            handle.resume();
+        }
     }
-    
+
+public:
+    explicit EjecutorCorrutinas(int num_hilos)
+        : hilos(num_hilos), tareas_vivas(0), detener(false) {
+        for (int i = 0; i < num_hilos; ++i) {
+            pthread_create(&hilos[i], nullptr, hiloEjecutor, this);
+        }
+    }
+
+    ~EjecutorCorrutinas() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            detener = true;
+        }
+        hay_trabajo.notify_all();
+        for (pthread_t& hilo : hilos) {
+            pthread_join(hilo, nullptr);
+        }
+    }
+
+    EjecutorCorrutinas(const EjecutorCorrutinas&) = delete;
+    EjecutorCorrutinas& operator=(const EjecutorCorrutinas&) = delete;
+
+    void programar(std::coroutine_handle<> handle) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            listas.push_back(handle);
+        }
+        hay_trabajo.notify_one();
+    }
+
+    void lanzar(Tarea tarea) {
+        std::coroutine_handle<Tarea::promise_type> handle = std::exchange(tarea.handle, nullptr);
+        handle.promise().ejecutor = this;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++tareas_vivas;
+        }
+        programar(handle);
+    }
+
+    void tareaTerminada() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--tareas_vivas == 0) {
+            sin_tareas.notify_all();
+        }
+    }
+
+    // Bloquea al hilo llamador hasta que terminan todas las tareas lanzadas
+    void esperarTareas() {
+        std::unique_lock<std::mutex> lock(mutex);
+        sin_tareas.wait(lock, [this] { return tareas_vivas == 0; });
+    }
+
+    int getNumHilos() const {
+        return static_cast<int>(hilos.size());
+    }
+};
+
+Tarea::promise_type::~promise_type() {
+    if (ejecutor != nullptr) {
+        ejecutor->tareaTerminada();
+    }
+}
+
+// Buffer acotado cuyas operaciones se esperan con co_await. Cuando hay una
+// corrutina esperando del otro lado, el elemento se le entrega directamente
+// y se la devuelve al ejecutor.
+template <typename T>
+class BufferAsincrono {
+public:
+    class OperacionProducir {
+    private:
+        BufferAsincrono* buffer;
+        T valor;
+        bool aceptado;
+        std::coroutine_handle<> handle;
+        OperacionProducir* siguiente;
+
+        friend class BufferAsincrono;
+
+    public:
+        OperacionProducir(BufferAsincrono* buffer, T&& valor)
+            : buffer(buffer), valor(std::move(valor)), aceptado(false), siguiente(nullptr) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> h) {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            if (buffer->done) {
+                return false;
+            }
+
+            if (OperacionConsumir* consumidor = buffer->consumidores.extraer()) {
+                consumidor->resultado.emplace(std::move(valor));
+                buffer->ejecutor->programar(consumidor->handle);
+                aceptado = true;
+                return false;
+            }
+
+            if (buffer->cantidad < buffer->max_size) {
+                buffer->encolar(std::move(valor));
+                aceptado = true;
+                return false;
+            }
+
+            handle = h;
+            buffer->productores.agregar(this);
+            return true;
+        }
+
+        // false si el buffer se cerró antes de aceptar el elemento
+        bool await_resume() const noexcept { return aceptado; }
+    };
+
+    class OperacionConsumir {
+    private:
+        BufferAsincrono* buffer;
+        std::optional<T> resultado;
+        std::coroutine_handle<> handle;
+        OperacionConsumir* siguiente;
+
+        friend class BufferAsincrono;
+
+    public:
+        explicit OperacionConsumir(BufferAsincrono* buffer) : buffer(buffer), siguiente(nullptr) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> h) {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            if (buffer->cantidad > 0) {
+                resultado.emplace(buffer->desencolar());
+
+                // Hay hueco: el primer productor aparcado deposita su elemento
+                if (OperacionProducir* productor = buffer->productores.extraer()) {
+                    buffer->encolar(std::move(productor->valor));
+                    productor->aceptado = true;
+                    buffer->ejecutor->programar(productor->handle);
+                }
+                return false;
+            }
+
+            if (buffer->done) {
+                return false;
+            }
+
+            handle = h;
+            buffer->consumidores.agregar(this);
+            return true;
+        }
+
+        // Vacío cuando el buffer está cerrado y agotado
+        std::optional<T> await_resume() { return std::move(resultado); }
+    };
+
+    BufferAsincrono(EjecutorCorrutinas& ejecutor, size_t size)
+        : ejecutor(&ejecutor), ranuras(new std::optional<T>[size]), cabeza(0), cantidad(0),
+          max_size(size), done(false) {}
+
+    BufferAsincrono(const BufferAsincrono&) = delete;
+    BufferAsincrono& operator=(const BufferAsincrono&) = delete;
+
+    OperacionProducir producir(T&& item) {
+        return OperacionProducir(this, std::move(item));
+    }
+
+    OperacionConsumir consumir() {
+        return OperacionConsumir(this);
+    }
+
+    // Cierra el buffer y despierta a todas las corrutinas aparcadas
+    void terminar() {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        while (OperacionProducir* productor = productores.extraer()) {
+            ejecutor->programar(productor->handle);
+        }
+        while (OperacionConsumir* consumidor = consumidores.extraer()) {
+            ejecutor->programar(consumidor->handle);
+        }
+    }
+
+private:
+    // Lista FIFO intrusiva: los nodos son las propias operaciones suspendidas
+    template <typename Operacion>
+    struct ListaEspera {
+        Operacion* primero = nullptr;
+        Operacion* ultimo = nullptr;
+
+        void agregar(Operacion* op) {
+            op->siguiente = nullptr;
+            if (ultimo != nullptr) {
+                ultimo->siguiente = op;
+            } else {
+                primero = op;
+            }
+            ultimo = op;
+        }
+
+        Operacion* extraer() {
+            Operacion* op = primero;
+            if (op != nullptr) {
+                primero = op->siguiente;
+                if (primero == nullptr) {
+                    ultimo = nullptr;
+                }
+            }
+            return op;
+        }
+    };
+
+    EjecutorCorrutinas* ejecutor;
+    std::unique_ptr<std::optional<T>[]> ranuras;
+    size_t cabeza;
+    size_t cantidad;
+    size_t max_size;
+    bool done;
+    std::mutex mutex;
+    ListaEspera<OperacionProducir> productores;
+    ListaEspera<OperacionConsumir> consumidores;
+
+    void encolar(T&& valor) {
+        ranuras[(cabeza + cantidad) % max_size].emplace(std::move(valor));
+        ++cantidad;
+    }
+
+    T desencolar() {
+        T valor = std::move(*ranuras[cabeza]);
+        ranuras[cabeza].reset();
+        cabeza = (cabeza + 1) % max_size;
+        --cantidad;
+        return valor;
+    }
+};
+
+Tarea productorAsincrono(BufferAsincrono<int>& buffer, int id, int num_items,
+                         std::atomic<int>& productores_restantes) {
+    for (int i = 0; i < num_items; ++i) {
+        if (!co_await buffer.producir(id * 1000 + i)) {
+            break;
+        }
+    }
+
+    // El último productor en terminar cierra el buffer
+    if (--productores_restantes == 0) {
+        buffer.terminar();
+    }
+}
+
+Tarea consumidorAsincrono(BufferAsincrono<int>& buffer, std::atomic<long long>& suma,
+                          std::atomic<long long>& consumidos) {
+    while (std::optional<int> item = co_await buffer.consumir()) {
+        suma += *item;
+        ++consumidos;
+    }
+}
+
+void ejecutarProductorConsumidorCorrutinas() {
+    const int NUM_HILOS_EJECUTOR = 4;
+    const int NUM_PRODUCTORES = 20000;
+    const int NUM_CONSUMIDORES = 20000;
+    const int ITEMS_POR_PRODUCTOR = 50;
+    const int BUFFER_SIZE = 64;
+
+    std::cout << "\nProductor-Consumidor con corrutinas: " << NUM_PRODUCTORES << " productores y "
+              << NUM_CONSUMIDORES << " consumidores sobre " << NUM_HILOS_EJECUTOR << " hilos" << std::endl;
+
+    std::atomic<int> productores_restantes(NUM_PRODUCTORES);
+    std::atomic<long long> suma(0);
+    std::atomic<long long> consumidos(0);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    {
+        EjecutorCorrutinas ejecutor(NUM_HILOS_EJECUTOR);
+        BufferAsincrono<int> buffer(ejecutor, BUFFER_SIZE);
+
+        for (int i = 0; i < NUM_CONSUMIDORES; ++i) {
+            ejecutor.lanzar(consumidorAsincrono(buffer, suma, consumidos));
+        }
+        for (int i = 0; i < NUM_PRODUCTORES; ++i) {
+            ejecutor.lanzar(productorAsincrono(buffer, i, ITEMS_POR_PRODUCTOR, productores_restantes));
+        }
+
+        ejecutor.esperarTareas();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto tiempo = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+    long long esperado = 0;
+    for (int p = 0; p < NUM_PRODUCTORES; ++p) {
+        for (int i = 0; i < ITEMS_POR_PRODUCTOR; ++i) {
+            esperado += p * 1000LL + i;
+        }
+    }
+
+    long long total_items = static_cast<long long>(NUM_PRODUCTORES) * ITEMS_POR_PRODUCTOR;
+    std::cout << "Elementos consumidos: " << consumidos << " de " << total_items << std::endl;
+    std::cout << "Resultado correcto: " << (suma == esperado && consumidos == total_items ? "✓" : "✗") << std::endl;
+    std::cout << "Tiempo: " << tiempo.count() << " ms" << std::endl;
+    std::cout << "Elementos/sec: " << std::fixed << std::setprecision(0)
+              << total_items / std::max(tiempo.count() / 1000.0, 1e-3) << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// Buffer fragmentado: un sub-buffer por productor para repartir la
+// contención del mutex único. En modo FIFO por fragmento cada consumidor
+// vacía primero su fragmento y roba de los demás cuando está vacío; en modo
+// FIFO estricto los elementos se reparten por turnos globales entre
+// fragmentos y se consumen exactamente en el orden en que se produjeron.
+template <typename T>
+class BufferFragmentado {
+public:
+    enum class ModoOrden { FIFO_POR_FRAGMENTO, FIFO_ESTRICTO };
+
+private:
+    struct alignas(64) Fragmento {
+        std::mutex mutex;
+        std::condition_variable not_full;
+        std::condition_variable not_empty;
+        std::unique_ptr<std::optional<T>[]> ranuras;
+        size_t cabeza = 0;
+        size_t cantidad = 0;
+        size_t turno_escritura = 0; // Sólo en modo FIFO estricto
+        size_t turno_lectura = 0;
+    };
+
+    std::unique_ptr<Fragmento[]> fragmentos;
+    size_t num_fragmentos;
+    size_t max_size;
+    ModoOrden modo;
+    std::atomic<bool> done;
+
+    // Espera global de consumidores sin trabajo en ningún fragmento
+    std::mutex mutex_global;
+    std::condition_variable hay_elementos;
+    std::atomic<long long> total;
+    std::atomic<int> durmiendo;
+
+    // Turnos globales del modo estricto
+    std::atomic<size_t> ticket_produccion;
+    std::atomic<size_t> ticket_consumo;
+    std::atomic<long long> robos;
+
+    // Requieren el mutex del fragmento tomado
+    void encolar(Fragmento& f, T&& valor) {
+        f.ranuras[(f.cabeza + f.cantidad) % max_size].emplace(std::move(valor));
+        ++f.cantidad;
+    }
+
+    void desencolar(Fragmento& f, T& item) {
+        item = std::move(*f.ranuras[f.cabeza]);
+        f.ranuras[f.cabeza].reset();
+        f.cabeza = (f.cabeza + 1) % max_size;
+        --f.cantidad;
+    }
+
+    bool intentarExtraer(size_t indice, T& item) {
+        Fragmento& f = fragmentos[indice];
+        std::lock_guard<std::mutex> lock(f.mutex);
+        if (f.cantidad == 0) {
+            return false;
+        }
+        desencolar(f, item);
+        --total;
+        f.not_full.notify_one();
+        return true;
+    }
+
+    void producirEstricto(T&& item) {
+        size_t ticket = ticket_produccion++;
+        Fragmento& f = fragmentos[ticket % num_fragmentos];
+        size_t turno = ticket / num_fragmentos;
+
+        std::unique_lock<std::mutex> lock(f.mutex);
+        f.not_full.wait(lock, [&] { return (f.turno_escritura == turno && f.cantidad < max_size) || done; });
+        if (done) {
+            return;
+        }
+        encolar(f, std::move(item));
+        ++f.turno_escritura;
+        ++total;
+        f.not_full.notify_all();
+        f.not_empty.notify_all();
+    }
+
+    bool consumirEstricto(T& item) {
+        size_t ticket = ticket_consumo++;
+        Fragmento& f = fragmentos[ticket % num_fragmentos];
+        size_t turno = ticket / num_fragmentos;
+
+        // Tras terminar(), un turno sin elemento asignado no llegará nunca
+        std::unique_lock<std::mutex> lock(f.mutex);
+        f.not_empty.wait(lock, [&] {
+            return (f.turno_lectura == turno && f.cantidad > 0) || (done && ticket >= ticket_produccion);
+        });
+        if (f.turno_lectura != turno || f.cantidad == 0) {
+            return false;
+        }
+        desencolar(f, item);
+        ++f.turno_lectura;
+        --total;
+        f.not_full.notify_all();
+        f.not_empty.notify_all();
+        return true;
+    }
+
+public:
+    BufferFragmentado(size_t num_fragmentos, size_t size_por_fragmento, ModoOrden modo)
+        : fragmentos(new Fragmento[num_fragmentos]), num_fragmentos(num_fragmentos),
+          max_size(size_por_fragmento), modo(modo), done(false), total(0), durmiendo(0),
+          ticket_produccion(0), ticket_consumo(0), robos(0) {
+        for (size_t i = 0; i < num_fragmentos; ++i) {
+            fragmentos[i].ranuras.reset(new std::optional<T>[size_por_fragmento]);
+        }
+    }
+
+    BufferFragmentado(const BufferFragmentado&) = delete;
+    BufferFragmentado& operator=(const BufferFragmentado&) = delete;
+
+    // `casa` identifica al productor; en modo estricto se ignora
+    void producir(size_t casa, T&& item) {
+        if (modo == ModoOrden::FIFO_ESTRICTO) {
+            producirEstricto(std::move(item));
+            return;
+        }
+
+        Fragmento& f = fragmentos[casa % num_fragmentos];
+        {
+            std::unique_lock<std::mutex> lock(f.mutex);
+            if (f.cantidad == max_size && !done) {
+                AmbitoTraza traza("buffer:espera fragmento lleno");
+                f.not_full.wait(lock, [&] { return f.cantidad < max_size || done; });
+            }
+            if (done) {
+                return;
+            }
+            encolar(f, std::move(item));
+        }
+
+        ++total;
+        if (durmiendo > 0) {
+            std::lock_guard<std::mutex> lock(mutex_global);
+            hay_elementos.notify_one();
+        }
+    }
+
+    // Devuelve false cuando el buffer está terminado y no quedan elementos
+    bool consumir(size_t casa, T& item) {
+        if (modo == ModoOrden::FIFO_ESTRICTO) {
+            return consumirEstricto(item);
+        }
+
+        while (true) {
+            for (size_t k = 0; k < num_fragmentos; ++k) {
+                if (intentarExtraer((casa + k) % num_fragmentos, item)) {
+                    if (k > 0) {
+                        ++robos;
+                    }
+                    return true;
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(mutex_global);
+            ++durmiendo;
+            if (total == 0 && !done) {
+                AmbitoTraza traza("buffer:espera vacío");
+                hay_elementos.wait(lock, [this] { return total > 0 || done; });
+            }
+            --durmiendo;
+            if (total == 0 && done) {
+                return false;
+            }
+        }
+    }
+
+    // Cierra todos los fragmentos a la vez
+    void terminar() {
+        done = true;
+        for (size_t i = 0; i < num_fragmentos; ++i) {
+            std::lock_guard<std::mutex> lock(fragmentos[i].mutex);
+            fragmentos[i].not_full.notify_all();
+            fragmentos[i].not_empty.notify_all();
+        }
+        std::lock_guard<std::mutex> lock(mutex_global);
+        hay_elementos.notify_all();
+    }
+
+    size_t size() const {
+        return static_cast<size_t>(total.load());
+    }
+
+    long long getRobos() const {
+        return robos;
+    }
+};
+
+struct BufferUnicoData {
+    BufferProductorConsumidor<int>* buffer;
+    int id;
+    int num_items;
+    long long suma;
+};
+
+void* productorSinEspera(void* arg) {
+    BufferUnicoData* data = static_cast<BufferUnicoData*>(arg);
+    AmbitoTraza traza("pc:productor", data->num_items);
+
+    for (int i = 0; i < data->num_items; ++i) {
+        data->buffer->producir(data->id * 1000000 + i);
+    }
+
+    return nullptr;
+}
+
+void* consumidorSinEspera(void* arg) {
+    BufferUnicoData* data = static_cast<BufferUnicoData*>(arg);
+    AmbitoTraza traza("pc:consumidor");
+
+    data->suma = 0;
+    int item;
+    while (data->buffer->consumir(item)) {
+        data->suma += item;
+    }
+
+    return nullptr;
+}
+
+struct FragmentadoData {
+    BufferFragmentado<int>* buffer;
+    int id;
+    int num_items;
+    long long suma;
+};
+
+void* productorFragmentado(void* arg) {
+    FragmentadoData* data = static_cast<FragmentadoData*>(arg);
+    AmbitoTraza traza("pc:productor fragmentado", data->num_items);
+
+    for (int i = 0; i < data->num_items; ++i) {
+        data->buffer->producir(data->id, data->id * 1000000 + i);
+    }
+
     return nullptr;
 }
 
-double reglaTrapezoidalParalela(double a, double b, int n, int num_threads) {
-    std::vector<pthread_t> threads(num_threads);
-    std::vector<TrapezoidalData> thread_data(num_threads);
+void* consumidorFragmentado(void* arg) {
+    FragmentadoData* data = static_cast<FragmentadoData*>(arg);
+    AmbitoTraza traza("pc:consumidor fragmentado");
+
+    data->suma = 0;
+    int item;
+    while (data->buffer->consumir(data->id, item)) {
+        data->suma += item;
+    }
+
+    return nullptr;
+}
+
+// Lanza `pares` productores y `pares` consumidores sobre el buffer indicado,
+// devuelve la suma consumida y deja en `tiempo` la duración
+template <typename Buffer, typename Data>
+long long medirBuffer(Buffer& buffer, int pares, int items_por_productor,
+                      void* (*funcion_productor)(void*), void* (*funcion_consumidor)(void*),
+                      std::chrono::milliseconds& tiempo) {
+    std::vector<pthread_t> productores(pares);
+    std::vector<pthread_t> consumidores(pares);
+    std::vector<Data> prod_data(pares);
+    std::vector<Data> cons_data(pares);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    {
+        AmbitoTraza traza("pc:crear hilos", 2 * pares);
+        for (int i = 0; i < pares; ++i) {
+            cons_data[i] = {&buffer, i, 0, 0};
+            pthread_create(&consumidores[i], nullptr, funcion_consumidor, &cons_data[i]);
+        }
+        for (int i = 0; i < pares; ++i) {
+            prod_data[i] = {&buffer, i, items_por_productor, 0};
+            pthread_create(&productores[i], nullptr, funcion_productor, &prod_data[i]);
+        }
+    }
+
+    for (int i = 0; i < pares; ++i) {
+        pthread_join(productores[i], nullptr);
+    }
+    buffer.terminar();
+
+    long long suma = 0;
+    for (int i = 0; i < pares; ++i) {
+        pthread_join(consumidores[i], nullptr);
+        suma += cons_data[i].suma;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    tiempo = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+    return suma;
+}
+
+void ejecutarProductorConsumidorFragmentado() {
+    const int TOTAL_ITEMS = 2000000;
+    const size_t BUFFER_SIZE = 256;
+    const int NUM_NUCLEOS = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "\nBuffer fragmentado con robo de trabajo (" << NUM_NUCLEOS << " núcleos)" << std::endl;
+    std::cout << std::setw(8) << "Pares" << std::setw(16) << "Único el/s"
+              << std::setw(16) << "Por fragm. el/s" << std::setw(16) << "Estricto el/s"
+              << std::setw(10) << "Robos" << std::setw(6) << "OK" << std::endl;
+
+    std::vector<int> configuraciones;
+    for (int pares = 1; pares < NUM_NUCLEOS; pares *= 2) {
+        configuraciones.push_back(pares);
+    }
+    configuraciones.push_back(NUM_NUCLEOS);
+
+    for (int pares : configuraciones) {
+        int items_por_productor = TOTAL_ITEMS / pares;
+        long long esperado = 0;
+        for (int p = 0; p < pares; ++p) {
+            for (int i = 0; i < items_por_productor; ++i) {
+                esperado += p * 1000000LL + i;
+            }
+        }
+
+        std::chrono::milliseconds tiempo_unico, tiempo_fragmentado, tiempo_estricto;
+
+        BufferProductorConsumidor<int> unico(BUFFER_SIZE);
+        long long suma_unico = medirBuffer<BufferProductorConsumidor<int>, BufferUnicoData>(
+            unico, pares, items_por_productor, productorSinEspera, consumidorSinEspera, tiempo_unico);
+
+        // El mismo número total de ranuras, repartido entre los fragmentos
+        size_t por_fragmento = std::max<size_t>(1, BUFFER_SIZE / pares);
+        BufferFragmentado<int> fragmentado(pares, por_fragmento, BufferFragmentado<int>::ModoOrden::FIFO_POR_FRAGMENTO);
+        long long suma_fragmentado = medirBuffer<BufferFragmentado<int>, FragmentadoData>(
+            fragmentado, pares, items_por_productor, productorFragmentado, consumidorFragmentado, tiempo_fragmentado);
+
+        BufferFragmentado<int> estricto(pares, por_fragmento, BufferFragmentado<int>::ModoOrden::FIFO_ESTRICTO);
+        long long suma_estricto = medirBuffer<BufferFragmentado<int>, FragmentadoData>(
+            estricto, pares, items_por_productor, productorFragmentado, consumidorFragmentado, tiempo_estricto);
+
+        long long total_items = static_cast<long long>(items_por_productor) * pares;
+        auto porSegundo = [total_items](std::chrono::milliseconds t) {
+            return total_items / std::max(t.count() / 1000.0, 1e-3);
+        };
+        bool correcto = suma_unico == esperado && suma_fragmentado == esperado && suma_estricto == esperado;
+
+        std::cout << std::fixed << std::setprecision(0)
+                  << std::setw(8) << pares << std::setw(16) << porSegundo(tiempo_unico)
+                  << std::setw(16) << porSegundo(tiempo_fragmentado)
+                  << std::setw(16) << porSegundo(tiempo_estricto)
+                  << std::setw(10) << fragmentado.getRobos()
+                  << std::setw(6) << (correcto ? "✓" : "✗") << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+void ejecutarProductorConsumidor() {
+    std::cout << "\n=== 1. PROBLEMA PRODUCTOR-CONSUMIDOR ===" << std::endl;
     
-    int chunk_size = n / num_threads;
+    const int BUFFER_SIZE = 10;
+    const int NUM_PRODUCTORES = 3;
+    const int NUM_CONSUMIDORES = 2;
+    const int ITEMS_POR_PRODUCTOR = 20;
     
-    // Crear y lanzar hilos
-    for (int i = 0; i < num_threads; ++i) {
-        thread_data[i].a = a;
-        thread_data[i].b = b;
-        thread_data[i].n = n;
-        thread_data[i].start_i = i * chunk_size;
-        thread_data[i].end_i = (i == num_threads - 1) ? n : (i + 1) * chunk_size;
+    BufferProductorConsumidor<int> buffer(BUFFER_SIZE);
+    std::vector<pthread_t> productores(NUM_PRODUCTORES);
+    std::vector<pthread_t> consumidores(NUM_CONSUMIDORES);
+    std::vector<ProductorConsumidorData> prod_data(NUM_PRODUCTORES);
+    std::vector<ProductorConsumidorData> cons_data(NUM_CONSUMIDORES);
+    
+    {
+        AmbitoTraza traza("pc:crear hilos", NUM_PRODUCTORES + NUM_CONSUMIDORES);
+        
+        // Crear productores
+        for (int i = 0; i < NUM_PRODUCTORES; ++i) {
+            prod_data[i] = {&buffer, i, ITEMS_POR_PRODUCTOR};
+            pthread_create(&productores[i], nullptr, productor, &prod_data[i]);
+        }
         
-        pthread_create(&threads[i], nullptr, reglaTrapezoidalParcial, &thread_data[i]);
+        // Crear consumidores
+        for (int i = 0; i < NUM_CONSUMIDORES; ++i) {
+            cons_data[i] = {&buffer, i, 0};
+            pthread_create(&consumidores[i], nullptr, consumidor, &cons_data[i]);
+        }
     }
     
-    // Esperar a que todos los hilos terminen
-    for (int i = 0; i < num_threads; ++i) {
-        pthread_join(threads[i], nullptr);
+    // Esperar a que los productores terminen
+    for (int i = 0; i < NUM_PRODUCTORES; ++i) {
+        pthread_join(productores[i], nullptr);
     }
     
-    // Calcular resultado final
-    double h = (b - a) / n;
-    double suma = 0.5 * (funcion(a) + funcion(b));
+    // Señalar que no hay más producción
+    buffer.terminar();
     
-    for (int i = 0; i < num_threads; ++i) {
-        suma += thread_data[i].partial_sum;
+    // Esperar a que los consumidores terminen
+    for (int i = 0; i < NUM_CONSUMIDORES; ++i) {
+        pthread_join(consumidores[i], nullptr);
+    }
+    
+    std::cout << "Productor-Consumidor completado exitosamente!" << std::endl;
+
+    ejecutarProductorConsumidorRegistros();
+    ejecutarProductorConsumidorCorrutinas();
+    ejecutarProductorConsumidorFragmentado();
+}
+
+// ============================================================================
+// 2. MULTIPLICACIÓN MATRIZ-VECTOR
+// ============================================================================
+
+template <typename T>
+struct MatrizVectorData {
+    const std::vector<std::vector<T>>* matriz;
+    const T* vector;
+    T* resultado;
+    int start_row;
+    int end_row;
+};
+
+// Producto punto vectorizado: la reducción se hace en registros SIMD
+template <typename T>
+inline T productoPunto(const T* fila, const T* vector, size_t m) {
+    T suma = 0;
+    #pragma omp simd reduction(+:suma)
+    for (size_t j = 0; j < m; ++j) {
+        suma += fila[j] * vector[j];
+    }
+    return suma;
+}
+
+template <typename T>
+void* multiplicarMatrizVectorParcial(void* arg) {
+    MatrizVectorData<T>* data = static_cast<MatrizVectorData<T>*>(arg);
+    AmbitoTraza traza("matvec:filas", data->end_row - data->start_row);
+    
+    for (int i = data->start_row; i < data->end_row; ++i) {
+        const std::vector<T>& fila = (*data->matriz)[i];
+        data->resultado[i] = productoPunto(fila.data(), data->vector, fila.size());
+    }
+    
+    return nullptr;
+}
+
+// Versión con salida del llamador: resultado tiene matriz.size() elementos
+// y los descriptores de hilo salen de la arena
+template <typename T>
+void multiplicarMatrizVectorParalelo(
+    const std::vector<std::vector<T>>& matriz,
+    const T* vector,
+    T* resultado,
+    int num_threads,
+    Arena& arena) {
+    
+    AmbitoArena ambito(arena);
+    int n = matriz.size();
+    pthread_t* threads = arena.reservar<pthread_t>(num_threads);
+    MatrizVectorData<T>* thread_data = arena.reservar<MatrizVectorData<T>>(num_threads);
+    
+    int chunk_size = n / num_threads;
+    
+    // Crear y lanzar hilos
+    {
+        AmbitoTraza traza("matvec:crear hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            thread_data[i].matriz = &matriz;
+            thread_data[i].vector = vector;
+            thread_data[i].resultado = resultado;
+            thread_data[i].start_row = i * chunk_size;
+            thread_data[i].end_row = (i == num_threads - 1) ? n : (i + 1) * chunk_size;
+            
+            pthread_create(&threads[i], nullptr, multiplicarMatrizVectorParcial<T>, &thread_data[i]);
+        }
+    }
+    
+    // Esperar a que todos los hilos terminen
+    {
+        AmbitoTraza traza("matvec:unir hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            pthread_join(threads[i], nullptr);
+        }
+    }
+}
+
+template <typename T>
+std::vector<T> multiplicarMatrizVectorParalelo(
+    const std::vector<std::vector<T>>& matriz,
+    const std::vector<T>& vector,
+    int num_threads) {
+    
+    std::vector<T> resultado(matriz.size(), 0);
+    Arena& arena = arenaDelHilo();
+    multiplicarMatrizVectorParalelo(matriz, vector.data(), resultado.data(), num_threads, arena);
+    return resultado;
+}
+
+// Multiplicación de una matriz por K vectores en una sola pasada. Los
+// vectores se intercalan (x[j*K + k]) para que cada elemento de la matriz
+// leído de memoria se use contra los K vectores con una operación SIMD.
+// Salida es vector<vector<int>> o VistaMatriz<int>: resultados[k][i].
+template <typename Salida>
+struct MatrizVectoresData {
+    const std::vector<std::vector<int>>* matriz;
+    const int* vectores_intercalados;
+    Salida* resultados;
+    int* acumulado; // K acumuladores propios del hilo
+    int num_vectores;
+    int start_row;
+    int end_row;
+};
+
+template <typename Salida>
+void* multiplicarMatrizVectoresParcial(void* arg) {
+    MatrizVectoresData<Salida>* data = static_cast<MatrizVectoresData<Salida>*>(arg);
+    AmbitoTraza traza("matvec:filas K vectores", data->end_row - data->start_row);
+    const int K = data->num_vectores;
+    const int* x = data->vectores_intercalados;
+    int* acc = data->acumulado;
+    
+    for (int i = data->start_row; i < data->end_row; ++i) {
+        const std::vector<int>& fila = (*data->matriz)[i];
+        std::fill(acc, acc + K, 0);
+        
+        for (size_t j = 0; j < fila.size(); ++j) {
+            const int a = fila[j];
+            const int* xj = x + j * K;
+            #pragma omp simd
+            for (int k = 0; k < K; ++k) {
+                acc[k] += a * xj[k];
+            }
+        }
+        
+        for (int k = 0; k < K; ++k) {
+            (*data->resultados)[k][i] = acc[k];
+        }
+    }
+    
+    return nullptr;
+}
+
+// resultados[k] = matriz * vectores[k], con el espacio de trabajo (vectores
+// intercalados, acumuladores y descriptores de hilo) tomado de la arena
+template <typename Salida>
+void multiplicarMatrizVectoresParalelo(
+    const std::vector<std::vector<int>>& matriz,
+    const std::vector<std::vector<int>>& vectores,
+    Salida& resultados,
+    int num_threads,
+    Arena& arena) {
+    
+    int n = matriz.size();
+    int K = vectores.size();
+    if (K == 0) return;
+    size_t m = vectores[0].size();
+    
+    AmbitoArena ambito(arena);
+    int* intercalados = arena.reservar<int>(m * K);
+    for (size_t j = 0; j < m; ++j) {
+        for (int k = 0; k < K; ++k) {
+            intercalados[j * K + k] = vectores[k][j];
+        }
+    }
+    
+    pthread_t* threads = arena.reservar<pthread_t>(num_threads);
+    MatrizVectoresData<Salida>* thread_data = arena.reservar<MatrizVectoresData<Salida>>(num_threads);
+    
+    int chunk_size = n / num_threads;
+    
+    // Crear y lanzar hilos
+    {
+        AmbitoTraza traza("matvec K vectores:crear hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            thread_data[i].matriz = &matriz;
+            thread_data[i].vectores_intercalados = intercalados;
+            thread_data[i].resultados = &resultados;
+            thread_data[i].acumulado = arena.reservar<int>(K);
+            thread_data[i].num_vectores = K;
+            thread_data[i].start_row = i * chunk_size;
+            thread_data[i].end_row = (i == num_threads - 1) ? n : (i + 1) * chunk_size;
+        
+            pthread_create(&threads[i], nullptr, multiplicarMatrizVectoresParcial<Salida>, &thread_data[i]);
+        }
+    }
+    
+    // Esperar a que todos los hilos terminen
+    {
+        AmbitoTraza traza("matvec K vectores:unir hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            pthread_join(threads[i], nullptr);
+        }
+    }
+}
+
+// Devuelve resultados[k] = matriz * vectores[k]
+std::vector<std::vector<int>> multiplicarMatrizVectoresParalelo(
+    const std::vector<std::vector<int>>& matriz,
+    const std::vector<std::vector<int>>& vectores,
+    int num_threads) {
+    
+    std::vector<std::vector<int>> resultados(vectores.size(), std::vector<int>(matriz.size(), 0));
+    Arena& arena = arenaDelHilo();
+    multiplicarMatrizVectoresParalelo(matriz, vectores, resultados, num_threads, arena);
+    return resultados;
+}
+
+void multiplicarMatrizVectorSecuencial(
+    const std::vector<std::vector<int>>& matriz,
+    const int* vector,
+    int* resultado) {
+    
+    int n = matriz.size();
+    
+    for (int i = 0; i < n; ++i) {
+        resultado[i] = 0;
+        for (size_t j = 0; j < matriz[i].size(); ++j) {
+            resultado[i] += matriz[i][j] * vector[j];
+        }
+    }
+}
+
+std::vector<int> multiplicarMatrizVectorSecuencial(
+    const std::vector<std::vector<int>>& matriz,
+    const std::vector<int>& vector) {
+    
+    std::vector<int> resultado(matriz.size(), 0);
+    multiplicarMatrizVectorSecuencial(matriz, vector.data(), resultado.data());
+    return resultado;
+}
+
+void ejecutarMultiplicacionMatrizVector() {
+    std::cout << "\n=== 2. MULTIPLICACIÓN MATRIZ-VECTOR ===" << std::endl;
+    
+    const int N = 2000; // Filas de matriz
+    const int M = 2000; // Columnas de matriz
+    const int NUM_THREADS = 8;
+    
+    // Generar matriz y vector
+    std::vector<std::vector<int>> matriz(N, std::vector<int>(M));
+    std::vector<int> vector(M);
+    
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> dis(1, 100);
+    
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < M; ++j) {
+            matriz[i][j] = dis(gen);
+        }
+    }
+    
+    for (int j = 0; j < M; ++j) {
+        vector[j] = dis(gen);
+    }
+    
+    std::cout << "Matriz: " << N << " x " << M << std::endl;
+    std::cout << "Vector: " << M << " elementos" << std::endl;
+    
+    // Medir versión secuencial
+    auto start = std::chrono::high_resolution_clock::now();
+    auto resultado_secuencial = multiplicarMatrizVectorSecuencial(matriz, vector);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto tiempo_secuencial = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    
+    // Medir versión paralela
+    start = std::chrono::high_resolution_clock::now();
+    auto resultado_paralelo = multiplicarMatrizVectorParalelo(matriz, vector, NUM_THREADS);
+    end = std::chrono::high_resolution_clock::now();
+    auto tiempo_paralelo = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    
+    // Verificar resultados
+    bool correcto = (resultado_secuencial == resultado_paralelo);
+    std::cout << "Resultado correcto: " << (correcto ? "✓" : "✗") << std::endl;
+    
+    // Análisis de rendimiento
+    double speedup = static_cast<double>(tiempo_secuencial.count()) / tiempo_paralelo.count();
+    double eficiencia = speedup / NUM_THREADS;
+    
+    std::cout << "Tiempo secuencial: " << tiempo_secuencial.count() << " ms" << std::endl;
+    std::cout << "Tiempo paralelo:   " << tiempo_paralelo.count() << " ms" << std::endl;
+    std::cout << "Speedup: " << speedup << "x" << std::endl;
+    std::cout << "Eficiencia: " << (eficiencia * 100) << "%" << std::endl;
+    
+    // Lote de K vectores contra la misma matriz
+    const int K = 32;
+    std::vector<std::vector<int>> vectores(K, std::vector<int>(M));
+    for (auto& v : vectores) {
+        for (int j = 0; j < M; ++j) {
+            v[j] = dis(gen);
+        }
+    }
+    
+    std::cout << "\nLote de " << K << " vectores contra la misma matriz" << std::endl;
+    
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<std::vector<int>> resultados_individuales;
+    for (int k = 0; k < K; ++k) {
+        resultados_individuales.push_back(multiplicarMatrizVectorParalelo(matriz, vectores[k], NUM_THREADS));
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double ms_individual = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    start = std::chrono::high_resolution_clock::now();
+    auto resultados_lote = multiplicarMatrizVectoresParalelo(matriz, vectores, NUM_THREADS);
+    end = std::chrono::high_resolution_clock::now();
+    double ms_lote = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    std::cout << "Resultado lote correcto: " << (resultados_lote == resultados_individuales ? "✓" : "✗") << std::endl;
+    
+    // Bytes de matriz leídos de memoria: K pasadas frente a una sola
+    double bytes_matriz = static_cast<double>(N) * M * sizeof(int);
+    std::cout << "Tiempo " << K << " llamadas: " << ms_individual << " ms ("
+              << (K * bytes_matriz / 1e6) / ms_individual << " GB/s)" << std::endl;
+    std::cout << "Tiempo en lote:    " << ms_lote << " ms ("
+              << (bytes_matriz / 1e6) / ms_lote << " GB/s)" << std::endl;
+    std::cout << "Speedup lote vs " << K << " llamadas: " << ms_individual / ms_lote << "x" << std::endl;
+}
+
+// ============================================================================
+// 3. REGLA TRAPEZOIDAL (INTEGRACIÓN NUMÉRICA)
+// ============================================================================
+
+enum class ReglaIntegracion { TRAPECIO, SIMPSON, GAUSS_LEGENDRE };
+
+// Suma compensada de Neumaier para combinar sumas parciales sin perder los
+// bits de menor peso cuando el número de términos es muy grande
+struct SumaCompensada {
+    double suma = 0.0;
+    double compensacion = 0.0;
+
+    void agregar(double valor) {
+        double t = suma + valor;
+        if (std::abs(suma) >= std::abs(valor)) {
+            compensacion += (suma - t) + valor;
+        } else {
+            compensacion += (valor - t) + suma;
+        }
+        suma = t;
+    }
+
+    double valor() const {
+        return suma + compensacion;
+    }
+};
+
+// Valor ponderado del nodo (o subintervalo, en Gauss-Legendre) i. Al ser una
+// plantilla sobre el integrando, f se expande en línea y el bucle se vectoriza.
+template <ReglaIntegracion R, typename F>
+inline double evaluarNodo(const F& f, double a, double h, long long i) {
+    if constexpr (R == ReglaIntegracion::TRAPECIO) {
+        return f(a + i * h);
+    } else if constexpr (R == ReglaIntegracion::SIMPSON) {
+        double peso = 2.0 + 2.0 * (i & 1); // 4 en nodos impares, 2 en pares
+        return peso * f(a + i * h);
+    } else {
+        // Gauss-Legendre de 3 puntos sobre [a + i·h, a + (i+1)·h]
+        const double t = 0.7745966692414834; // sqrt(3/5)
+        double medio = a + (i + 0.5) * h;
+        double semi = 0.5 * h;
+        return (5.0 / 9.0) * f(medio - semi * t) + (8.0 / 9.0) * f(medio) + (5.0 / 9.0) * f(medio + semi * t);
+    }
+}
+
+// Suma los nodos [desde, hasta) en CARRILES acumuladores independientes con
+// suma de Kahan; cada carril es un elemento del registro SIMD
+template <ReglaIntegracion R, typename F>
+SumaCompensada sumarNodos(const F& f, double a, double h, long long desde, long long hasta) {
+    constexpr int CARRILES = 8;
+    double suma[CARRILES] = {};
+    double compensacion[CARRILES] = {};
+
+    long long i = desde;
+    for (; i + CARRILES <= hasta; i += CARRILES) {
+        #pragma omp simd
+        for (int l = 0; l < CARRILES; ++l) {
+            double y = evaluarNodo<R>(f, a, h, i + l) - compensacion[l];
+            double t = suma[l] + y;
+            compensacion[l] = (t - suma[l]) - y;
+            suma[l] = t;
+        }
+    }
+
+    SumaCompensada total;
+    for (int l = 0; l < CARRILES; ++l) {
+        total.agregar(suma[l]);
+        total.agregar(-compensacion[l]);
+    }
+    for (; i < hasta; ++i) {
+        total.agregar(evaluarNodo<R>(f, a, h, i));
+    }
+    return total;
+}
+
+template <typename F>
+SumaCompensada sumarNodos(const F& f, ReglaIntegracion regla, double a, double h, long long desde, long long hasta) {
+    switch (regla) {
+        case ReglaIntegracion::TRAPECIO:
+            return sumarNodos<ReglaIntegracion::TRAPECIO>(f, a, h, desde, hasta);
+        case ReglaIntegracion::SIMPSON:
+            return sumarNodos<ReglaIntegracion::SIMPSON>(f, a, h, desde, hasta);
+        default:
+            return sumarNodos<ReglaIntegracion::GAUSS_LEGENDRE>(f, a, h, desde, hasta);
+    }
+}
+
+// Nodos [desde, hasta) que suma cada regla: los extremos del trapecio y de
+// Simpson se tratan aparte; Gauss-Legendre recorre los n subintervalos
+inline void rangoNodos(ReglaIntegracion regla, long long n, long long& desde, long long& hasta) {
+    desde = (regla == ReglaIntegracion::GAUSS_LEGENDRE) ? 0 : 1;
+    hasta = n;
+}
+
+// Simpson necesita un número par de subintervalos
+inline long long ajustarIntervalos(ReglaIntegracion regla, long long n) {
+    return (regla == ReglaIntegracion::SIMPSON && n % 2 != 0) ? n + 1 : n;
+}
+
+template <typename F>
+double combinarIntegral(const F& f, ReglaIntegracion regla, double a, double b, double h, SumaCompensada suma) {
+    switch (regla) {
+        case ReglaIntegracion::TRAPECIO:
+            suma.agregar(0.5 * (f(a) + f(b)));
+            return h * suma.valor();
+        case ReglaIntegracion::SIMPSON:
+            suma.agregar(f(a) + f(b));
+            return h / 3.0 * suma.valor();
+        default:
+            return 0.5 * h * suma.valor();
+    }
+}
+
+template <typename F>
+double integrarSecuencial(const F& f, double a, double b, long long n, ReglaIntegracion regla) {
+    n = ajustarIntervalos(regla, n);
+    double h = (b - a) / n;
+    long long desde, hasta;
+    rangoNodos(regla, n, desde, hasta);
+
+    return combinarIntegral(f, regla, a, b, h, sumarNodos(f, regla, a, h, desde, hasta));
+}
+
+template <typename F>
+struct IntegracionData {
+    const F* f;
+    ReglaIntegracion regla;
+    double a, h;
+    long long start_i, end_i;
+    SumaCompensada partial_sum;
+};
+
+template <typename F>
+void* integrarParcial(void* arg) {
+    IntegracionData<F>* data = static_cast<IntegracionData<F>*>(arg);
+    AmbitoTraza traza("integral:nodos", data->end_i - data->start_i);
+    data->partial_sum = sumarNodos(*data->f, data->regla, data->a, data->h, data->start_i, data->end_i);
+    return nullptr;
+}
+
+template <typename F>
+double integrarParalelo(const F& f, double a, double b, long long n, ReglaIntegracion regla, int num_threads,
+                        Arena& arena) {
+    n = ajustarIntervalos(regla, n);
+    double h = (b - a) / n;
+    long long desde, hasta;
+    rangoNodos(regla, n, desde, hasta);
+
+    AmbitoArena ambito(arena);
+    pthread_t* threads = arena.reservar<pthread_t>(num_threads);
+    IntegracionData<F>* thread_data = arena.reservar<IntegracionData<F>>(num_threads);
+
+    long long chunk_size = (hasta - desde) / num_threads;
+
+    // Crear y lanzar hilos
+    {
+        AmbitoTraza traza("integral:crear hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            thread_data[i].f = &f;
+            thread_data[i].regla = regla;
+            thread_data[i].a = a;
+            thread_data[i].h = h;
+            thread_data[i].start_i = desde + i * chunk_size;
+            thread_data[i].end_i = (i == num_threads - 1) ? hasta : desde + (i + 1) * chunk_size;
+
+            pthread_create(&threads[i], nullptr, integrarParcial<F>, &thread_data[i]);
+        }
+    }
+
+    // Esperar a que todos los hilos terminen
+    {
+        AmbitoTraza traza("integral:unir hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            pthread_join(threads[i], nullptr);
+        }
+    }
+
+    // Combinar los parciales con suma compensada
+    SumaCompensada suma;
+    for (int i = 0; i < num_threads; ++i) {
+        suma.agregar(thread_data[i].partial_sum.suma);
+        suma.agregar(thread_data[i].partial_sum.compensacion);
+    }
+
+    return combinarIntegral(f, regla, a, b, h, suma);
+}
+
+template <typename F>
+double integrarParalelo(const F& f, double a, double b, long long n, ReglaIntegracion regla, int num_threads) {
+    Arena& arena = arenaDelHilo();
+    return integrarParalelo(f, a, b, n, regla, num_threads, arena);
+}
+
+template <typename F>
+double reglaTrapezoidalSecuencial(const F& f, double a, double b, long long n) {
+    return integrarSecuencial(f, a, b, n, ReglaIntegracion::TRAPECIO);
+}
+
+template <typename F>
+double reglaTrapezoidalParalela(const F& f, double a, double b, long long n, int num_threads) {
+    return integrarParalelo(f, a, b, n, ReglaIntegracion::TRAPECIO, num_threads);
+}
+
+// Cuadratura adaptativa paralela: cada subintervalo se evalúa con la pareja
+// Gauss-Kronrod 7-15 y se divide en dos mientras el error estimado supere su
+// parte proporcional de la tolerancia. Las subdivisiones se reparten entre
+// hilos con robo de trabajo.
+
+struct Subintervalo {
+    double a, b;
+    int profundidad;
+};
+
+// Deque de tareas de un hilo: el dueño trabaja por el final (LIFO, buena
+// localidad) y los ladrones se llevan del principio los intervalos más grandes
+template <typename T>
+class alignas(64) DequeRobo {
+private:
+    std::mutex mutex;
+    std::deque<T> tareas;
+
+public:
+    void empujar(const T& tarea) {
+        std::lock_guard<std::mutex> lock(mutex);
+        tareas.push_back(tarea);
+    }
+
+    bool sacar(T& tarea) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tareas.empty()) {
+            return false;
+        }
+        tarea = tareas.back();
+        tareas.pop_back();
+        return true;
+    }
+
+    bool robar(T& tarea) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tareas.empty()) {
+            return false;
+        }
+        tarea = tareas.front();
+        tareas.pop_front();
+        return true;
+    }
+};
+
+// Regla de Kronrod de 15 puntos con la de Gauss de 7 puntos anidada; la
+// diferencia entre ambas es la estimación del error
+template <typename F>
+double gaussKronrod15(const F& f, double a, double b, double& error) {
+    static const double xgk[8] = {
+        0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+        0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+        0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+        0.207784955007898467600689403773245, 0.000000000000000000000000000000000};
+    static const double wgk[8] = {
+        0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+        0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+        0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+        0.204432940075298892414161999234649, 0.209482141084727828012999174891714};
+    static const double wg[4] = {
+        0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+        0.381830050505118944950369775488975, 0.417959183673469387755102040816327};
+
+    double centro = 0.5 * (a + b);
+    double semi = 0.5 * (b - a);
+    double fc = f(centro);
+    double kronrod = fc * wgk[7];
+    double gauss = fc * wg[3];
+
+    for (int j = 0; j < 7; ++j) {
+        double dx = semi * xgk[j];
+        double suma = f(centro - dx) + f(centro + dx);
+        kronrod += wgk[j] * suma;
+        if (j % 2 == 1) {
+            gauss += wg[j / 2] * suma;
+        }
+    }
+
+    error = std::abs((kronrod - gauss) * semi);
+    return kronrod * semi;
+}
+
+template <typename F>
+struct CuadraturaCompartida {
+    const F* f;
+    double tolerancia_por_unidad; // Tolerancia por unidad de longitud del intervalo
+    int profundidad_maxima;
+    int num_threads;
+    std::unique_ptr<DequeRobo<Subintervalo>[]> deques;
+    std::atomic<long long> pendientes; // Subintervalos creados y aún no resueltos
+
+    // Los hilos sin trabajo duermen tras unos intentos de robo fallidos y se
+    // despiertan cuando alguien publica subintervalos o se acaba el trabajo.
+    // publicaciones cambia en cada aviso, así que un aviso dado entre el
+    // último intento de robo y la espera no se pierde.
+    std::mutex mutex_espera;
+    std::condition_variable hay_trabajo;
+    std::atomic<int> durmiendo{0};
+    std::atomic<unsigned long long> publicaciones{0};
+
+    void avisar() {
+        ++publicaciones;
+        if (durmiendo > 0) {
+            { std::lock_guard<std::mutex> lock(mutex_espera); }
+            hay_trabajo.notify_all();
+        }
+    }
+};
+
+template <typename F>
+struct CuadraturaData {
+    CuadraturaCompartida<F>* compartida;
+    int id;
+    SumaCompensada resultado;
+    SumaCompensada error;
+    long long evaluaciones;
+    long long subintervalos;
+    long long robos;
+};
+
+template <typename F>
+void* cuadraturaParcial(void* arg) {
+    CuadraturaData<F>* data = static_cast<CuadraturaData<F>*>(arg);
+    AmbitoTraza traza("cuadratura:hilo");
+    CuadraturaCompartida<F>& compartida = *data->compartida;
+    const int P = compartida.num_threads;
+    data->evaluaciones = 0;
+    data->subintervalos = 0;
+    data->robos = 0;
+
+    while (compartida.pendientes > 0) {
+        Subintervalo s;
+        if (!compartida.deques[data->id].sacar(s)) {
+            // Sin trabajo propio: sólo este hilo llena su deque, así que se
+            // intenta robar hasta conseguir algo o hasta que no quede nada.
+            // Tras REINTENTOS_ROBO rondas fallidas el hilo duerme en lugar de
+            // ocupar un núcleo durante los tramos finales en serie.
+            const int REINTENTOS_ROBO = 16;
+            AmbitoTraza traza_robo("cuadratura:robar");
+            bool robado = false;
+            int intentos = 0;
+            while (!robado && compartida.pendientes > 0) {
+                unsigned long long visto = compartida.publicaciones;
+                for (int k = 1; k < P && !robado; ++k) {
+                    robado = compartida.deques[(data->id + k) % P].robar(s);
+                }
+                if (robado) {
+                    break;
+                }
+                if (++intentos < REINTENTOS_ROBO) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(compartida.mutex_espera);
+                ++compartida.durmiendo;
+                if (compartida.publicaciones == visto && compartida.pendientes > 0) {
+                    AmbitoTraza traza_espera("cuadratura:espera trabajo");
+                    compartida.hay_trabajo.wait(lock, [&compartida, visto] {
+                        return compartida.publicaciones != visto || compartida.pendientes == 0;
+                    });
+                }
+                --compartida.durmiendo;
+                intentos = 0;
+            }
+            if (!robado) {
+                break;
+            }
+            ++data->robos;
+        }
+
+        double error;
+        double valor = gaussKronrod15(*compartida.f, s.a, s.b, error);
+        data->evaluaciones += 15;
+        ++data->subintervalos;
+
+        if (error <= compartida.tolerancia_por_unidad * (s.b - s.a) || s.profundidad >= compartida.profundidad_maxima) {
+            data->resultado.agregar(valor);
+            data->error.agregar(error);
+            if (--compartida.pendientes == 0) {
+                compartida.avisar();
+            }
+        } else {
+            // Dos hijos sustituyen a este intervalo: +1 neto antes de publicarlos
+            ++compartida.pendientes;
+            double medio = 0.5 * (s.a + s.b);
+            compartida.deques[data->id].empujar({medio, s.b, s.profundidad + 1});
+            compartida.deques[data->id].empujar({s.a, medio, s.profundidad + 1});
+            compartida.avisar();
+        }
+    }
+
+    return nullptr;
+}
+
+struct ResultadoAdaptativo {
+    double valor;
+    double error_estimado;
+    long long evaluaciones;
+    long long subintervalos;
+    long long robos;
+    long long min_subintervalos_hilo; // Reparto final de la carga
+    long long max_subintervalos_hilo;
+};
+
+// Versión con espacio de trabajo del llamador: los descriptores de hilo y
+// sus resultados salen de la arena. Los deques de robo no: tienen mutex y
+// crecen según se subdivide el intervalo, así que siguen en el heap.
+template <typename F>
+ResultadoAdaptativo cuadraturaAdaptativaParalela(const F& f, double a, double b, double tolerancia,
+                                                 int num_threads, Arena& arena, int profundidad_maxima = 50) {
+    CuadraturaCompartida<F> compartida;
+    compartida.f = &f;
+    compartida.tolerancia_por_unidad = tolerancia / (b - a);
+    compartida.profundidad_maxima = profundidad_maxima;
+    compartida.num_threads = num_threads;
+    compartida.deques.reset(new DequeRobo<Subintervalo>[num_threads]);
+    // Cada hilo empieza con un tramo igual de [a, b]; si el trabajo se
+    // concentra en unos pocos tramos, los demás hilos lo roban
+    compartida.pendientes = num_threads;
+    double ancho = (b - a) / num_threads;
+    for (int i = 0; i < num_threads; ++i) {
+        double hasta = (i == num_threads - 1) ? b : a + (i + 1) * ancho;
+        compartida.deques[i].empujar({a + i * ancho, hasta, 0});
+    }
+
+    AmbitoArena ambito(arena);
+    pthread_t* threads = arena.reservar<pthread_t>(num_threads);
+    CuadraturaData<F>* thread_data = arena.reservar<CuadraturaData<F>>(num_threads);
+
+    {
+        AmbitoTraza traza("cuadratura:crear hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            thread_data[i] = CuadraturaData<F>();
+            thread_data[i].compartida = &compartida;
+            thread_data[i].id = i;
+            pthread_create(&threads[i], nullptr, cuadraturaParcial<F>, &thread_data[i]);
+        }
+    }
+
+    {
+        AmbitoTraza traza("cuadratura:unir hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            pthread_join(threads[i], nullptr);
+        }
+    }
+
+    SumaCompensada valor, error;
+    ResultadoAdaptativo resultado = {0, 0, 0, 0, 0, thread_data[0].subintervalos, thread_data[0].subintervalos};
+    for (int i = 0; i < num_threads; ++i) {
+        const CuadraturaData<F>& data = thread_data[i];
+        resultado.min_subintervalos_hilo = std::min(resultado.min_subintervalos_hilo, data.subintervalos);
+        resultado.max_subintervalos_hilo = std::max(resultado.max_subintervalos_hilo, data.subintervalos);
+        valor.agregar(data.resultado.suma);
+        valor.agregar(data.resultado.compensacion);
+        error.agregar(data.error.valor());
+        resultado.evaluaciones += data.evaluaciones;
+        resultado.subintervalos += data.subintervalos;
+        resultado.robos += data.robos;
+    }
+    resultado.valor = valor.valor();
+    resultado.error_estimado = error.valor();
+    return resultado;
+}
+
+template <typename F>
+ResultadoAdaptativo cuadraturaAdaptativaParalela(const F& f, double a, double b, double tolerancia,
+                                                 int num_threads, int profundidad_maxima = 50) {
+    return cuadraturaAdaptativaParalela(f, a, b, tolerancia, num_threads, arenaDelHilo(), profundidad_maxima);
+}
+
+// Compara la cuadratura adaptativa con el trapecio uniforme, duplicando el
+// número de trapecios hasta alcanzar la misma tolerancia. El coste del
+// trapecio es el de toda la búsqueda: sin conocer el valor exacto no se
+// sabría qué n basta, así que cuentan todas las pasadas. Devuelve el
+// resultado adaptativo para que el llamador compruebe el reparto.
+template <typename F>
+ResultadoAdaptativo compararCuadraturaAdaptativa(const char* nombre, const F& f, double a, double b, double exacto,
+                                                 double tolerancia, int num_threads) {
+    auto start = std::chrono::high_resolution_clock::now();
+    ResultadoAdaptativo adaptativa = cuadraturaAdaptativaParalela(f, a, b, tolerancia, num_threads);
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms_adaptativa = std::chrono::duration<double, std::milli>(end - start).count();
+
+    const long long MAX_TRAPECIOS = 1LL << 30;
+    long long n = 1024;
+    double uniforme = 0.0;
+    double ms_uniforme = 0.0;
+    long long evaluaciones_uniforme = 0;
+    while (true) {
+        start = std::chrono::high_resolution_clock::now();
+        uniforme = reglaTrapezoidalParalela(f, a, b, n, num_threads);
+        end = std::chrono::high_resolution_clock::now();
+        ms_uniforme += std::chrono::duration<double, std::milli>(end - start).count();
+        evaluaciones_uniforme += n + 1;
+        if (std::abs(uniforme - exacto) <= tolerancia || n >= MAX_TRAPECIOS) {
+            break;
+        }
+        n *= 2;
+    }
+
+    std::cout << nombre << std::endl;
+    std::cout << std::scientific << std::setprecision(2)
+              << "  Adaptativa GK15: error " << std::abs(adaptativa.valor - exacto)
+              << " (estimado " << adaptativa.error_estimado << ")"
+              << std::fixed << std::setprecision(1)
+              << ", evaluaciones " << adaptativa.evaluaciones
+              << ", subintervalos " << adaptativa.subintervalos
+              << ", robos " << adaptativa.robos
+              << " (subintervalos por hilo " << adaptativa.min_subintervalos_hilo
+              << "-" << adaptativa.max_subintervalos_hilo << ")"
+              << ", tiempo " << ms_adaptativa << " ms" << std::endl;
+    std::cout << std::scientific << std::setprecision(2)
+              << "  Trapecio uniforme: error " << std::abs(uniforme - exacto)
+              << std::fixed << std::setprecision(1)
+              << ", trapecios finales " << n
+              << ", evaluaciones " << evaluaciones_uniforme
+              << ", tiempo " << ms_uniforme << " ms" << std::endl;
+    std::cout.unsetf(std::ios::fixed | std::ios::scientific);
+    std::cout << std::setprecision(6);
+    return adaptativa;
+}
+
+void ejecutarReglaTrapezoidal() {
+    std::cout << "\n=== 3. REGLA TRAPEZOIDAL (INTEGRACIÓN NUMÉRICA) ===" << std::endl;
+    
+    const double A = 0.0; // Límite inferior
+    const double B = 1.0; // Límite superior
+    const long long N = 10000000; // Número de trapecios
+    const int NUM_THREADS = 8;
+    
+    auto funcion = [](double x) { return x * x; }; // f(x) = x²
+    
+    std::cout << "Integrando f(x) = x² desde " << A << " hasta " << B << std::endl;
+    std::cout << "Número de trapecios: " << N << std::endl;
+    std::cout << "Valor teórico: " << (B*B*B - A*A*A) / 3.0 << std::endl;
+    
+    // Medir versión secuencial
+    auto start = std::chrono::high_resolution_clock::now();
+    double resultado_secuencial = reglaTrapezoidalSecuencial(funcion, A, B, N);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto tiempo_secuencial = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    
+    // Medir versión paralela
+    start = std::chrono::high_resolution_clock::now();
+    double resultado_paralelo = reglaTrapezoidalParalela(funcion, A, B, N, NUM_THREADS);
+    end = std::chrono::high_resolution_clock::now();
+    auto tiempo_paralelo = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    
+    std::cout << "Resultado secuencial: " << std::fixed << std::setprecision(10) << resultado_secuencial << std::endl;
+    std::cout << "Resultado paralelo:   " << resultado_paralelo << std::endl;
+    
+    // Análisis de rendimiento
+    double speedup = static_cast<double>(tiempo_secuencial.count()) / tiempo_paralelo.count();
+    double eficiencia = speedup / NUM_THREADS;
+    
+    std::cout << "Tiempo secuencial: " << tiempo_secuencial.count() << " ms" << std::endl;
+    std::cout << "Tiempo paralelo:   " << tiempo_paralelo.count() << " ms" << std::endl;
+    std::cout << "Speedup: " << speedup << "x" << std::endl;
+    std::cout << "Eficiencia: " << (eficiencia * 100) << "%" << std::endl;
+    
+    // Otras reglas sobre f(x) = 4 / (1 + x²), cuya integral en [0, 1] es π
+    auto integrando_pi = [](double x) { return 4.0 / (1.0 + x * x); };
+    const double PI = 3.14159265358979323846;
+    
+    struct CasoIntegracion {
+        const char* nombre;
+        ReglaIntegracion regla;
+        long long n;
+    };
+    const CasoIntegracion casos[] = {
+        {"Trapecio", ReglaIntegracion::TRAPECIO, 1000000},
+        {"Simpson", ReglaIntegracion::SIMPSON, 1000000},
+        {"Gauss-Legendre 3", ReglaIntegracion::GAUSS_LEGENDRE, 1000000},
+        {"Trapecio", ReglaIntegracion::TRAPECIO, 2200000000LL}, // Más de 2^31 intervalos
+    };
+    
+    std::cout << "\nIntegrando f(x) = 4 / (1 + x²) desde 0 hasta 1 (valor teórico π)" << std::endl;
+    for (const CasoIntegracion& caso : casos) {
+        start = std::chrono::high_resolution_clock::now();
+        double resultado = integrarParalelo(integrando_pi, 0.0, 1.0, caso.n, caso.regla, NUM_THREADS);
+        end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        
+        std::cout << std::left << std::setw(18) << caso.nombre << std::right
+                  << " n = " << std::setw(10) << caso.n
+                  << "  resultado: " << std::fixed << std::setprecision(15) << resultado
+                  << "  error: " << std::scientific << std::setprecision(2) << std::abs(resultado - PI)
+                  << "  tiempo: " << std::fixed << std::setprecision(1) << ms << " ms" << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed | std::ios::scientific);
+    std::cout << std::setprecision(6);
+    
+    // Integrandos donde el espaciado uniforme desperdicia evaluaciones
+    const double TOLERANCIA = 1e-10;
+    const double EPS = 0.01;
+    auto pico = [EPS](double x) { return 1.0 / ((x - 0.3) * (x - 0.3) + EPS * EPS); };
+    double exacto_pico = (std::atan(0.7 / EPS) + std::atan(0.3 / EPS)) / EPS;
+    
+    const double K = 50.0;
+    auto oscilante = [K](double x) { return std::exp(-x) * std::cos(K * x); };
+    double exacto_oscilante = (std::exp(-1.0) * (K * std::sin(K) - std::cos(K)) + 1.0) / (1.0 + K * K);
+    
+    std::cout << "\nCuadratura adaptativa con robo de trabajo (tolerancia " << TOLERANCIA << ")" << std::endl;
+    compararCuadraturaAdaptativa("f(x) = 1 / ((x - 0.3)² + 0.01²) en [0, 1]", pico, 0.0, 1.0,
+                                 exacto_pico, TOLERANCIA, NUM_THREADS);
+    compararCuadraturaAdaptativa("f(x) = e^(-x)·cos(50x) en [0, 1]", oscilante, 0.0, 1.0,
+                                 exacto_oscilante, TOLERANCIA, NUM_THREADS);
+    
+    // Dilogaritmo por su serie Li2(x) = Σ x^k / k²: cada evaluación suma
+    // términos hasta que dejan de contar, de unos pocos cerca de 0 a ~10^6
+    // cerca de B_DILOG, y es allí donde además se subdivide. El trabajo se
+    // concentra en el último tramo inicial y el resto de hilos sólo lo
+    // reparten robándolo. La integral exacta sale de integrar la serie
+    // término a término.
+    const double B_DILOG = 0.99999;
+    auto dilogaritmo = [](double x) {
+        double suma = 0.0;
+        double potencia = x;
+        for (double k = 1.0; potencia > 1e-17 * k * k; k += 1.0) {
+            suma += potencia / (k * k);
+            potencia *= x;
+        }
+        return suma;
+    };
+    double exacto_dilog = 0.0;
+    double potencia = B_DILOG * B_DILOG;
+    for (double k = 1.0; potencia > 1e-17 * k * k * k; k += 1.0) {
+        exacto_dilog += potencia / (k * k * (k + 1.0));
+        potencia *= B_DILOG;
+    }
+    ResultadoAdaptativo adaptativa_dilog = compararCuadraturaAdaptativa(
+        "Li2(x) por su serie en [0, 0.99999] (coste creciente hacia la derecha)", dilogaritmo, 0.0, B_DILOG,
+        exacto_dilog, TOLERANCIA, NUM_THREADS);
+    std::cout << "Robo de trabajo con coste desigual: "
+              << (adaptativa_dilog.robos > 0 && std::abs(adaptativa_dilog.valor - exacto_dilog) <= TOLERANCIA ? "✓" : "✗")
+              << std::endl;
+}
+
+// ============================================================================
+// 4. COUNT SORT PARALELO
+// ============================================================================
+
+// Índice de un elemento en la entrada para los modos clave-valor y argsort.
+// 32 bits bastan para los tamaños de este repositorio y reducen a la mitad
+// el tráfico de memoria frente a size_t.
+using IndiceOrden = uint32_t;
+
+// Estado compartido por las fases del count sort paralelo. La fila t de
+// histogramas (paso_histograma contadores) guarda primero cuántas veces
+// aparece min_val + v en el trozo t de la entrada y, tras el prefijo, la
+// posición de salida del siguiente de ellos. indices, si no es nulo, recibe
+// la posición en la entrada de cada elemento de la salida (modo argsort).
+struct CountSortCompartido {
+    const int* input;
+    int* output;
+    IndiceOrden* indices;
+    size_t* histogramas;
+    size_t paso_histograma; // range redondeado a líneas de caché completas
+    size_t num_trozos;
+    int min_val;
+    size_t range;
+};
+
+struct CountSortData {
+    CountSortCompartido* compartido;
+    int id;
+    size_t start, end; // Trozo de la entrada
+    int local_min, local_max;
+};
+
+// Fase 1: mínimo y máximo del trozo en una sola pasada
+void* countSortMinMax(void* arg) {
+    CountSortData* data = static_cast<CountSortData*>(arg);
+    AmbitoTraza traza("countsort:minmax", data->end - data->start);
+    const int* input = data->compartido->input;
+    
+    int local_min = input[data->start];
+    int local_max = input[data->start];
+    for (size_t i = data->start; i < data->end; ++i) {
+        local_min = std::min(local_min, input[i]);
+        local_max = std::max(local_max, input[i]);
+    }
+    data->local_min = local_min;
+    data->local_max = local_max;
+    
+    return nullptr;
+}
+
+// Fase 2: histograma privado del trozo, sin compartir contadores
+void* countSortHistograma(void* arg) {
+    CountSortData* data = static_cast<CountSortData*>(arg);
+    AmbitoTraza traza("countsort:histograma", data->end - data->start);
+    CountSortCompartido* c = data->compartido;
+    const int* input = c->input;
+    size_t* histograma = c->histogramas + data->id * c->paso_histograma;
+    
+    std::fill(histograma, histograma + c->range, 0);
+    for (size_t i = data->start; i < data->end; ++i) {
+        histograma[input[i] - c->min_val]++;
+    }
+    
+    return nullptr;
+}
+
+// Fase 3: prefijo exclusivo de los histogramas en su sitio. El escaneo
+// recorre la matriz en orden cubeta × trozo (elemento k = v * num_trozos + t)
+// para que los elementos iguales conserven el orden de la entrada, leyendo y
+// escribiendo las filas privadas sin trasponerlas a otra matriz.
+void countSortPrefijo(CountSortCompartido& c, int num_threads, Arena& arena) {
+    const size_t P = c.num_trozos;
+    auto recorrer = [&c, P](size_t desde, size_t hasta, auto&& visitar) {
+        size_t v = desde / P;
+        size_t t = desde % P;
+        for (size_t k = desde; k < hasta; ++k) {
+            visitar(c.histogramas[t * c.paso_histograma + v]);
+            if (++t == P) {
+                t = 0;
+                ++v;
+            }
+        }
+    };
+    
+    escaneo_detalle::motorEscaneo(c.range * P, num_threads, BackendEscaneo::PTHREAD, &arena, size_t(0),
+        [&](size_t desde, size_t hasta) {
+            size_t suma = 0;
+            recorrer(desde, hasta, [&suma](size_t& celda) { suma += celda; });
+            return suma;
+        },
+        std::plus<size_t>(),
+        [&](size_t desde, size_t hasta, size_t prefijo) {
+            recorrer(desde, hasta, [&prefijo](size_t& celda) {
+                size_t cuenta = celda;
+                celda = prefijo;
+                prefijo += cuenta;
+            });
+        });
+}
+
+// Fase 4: cada hilo escribe su trozo, hacia delante, en las posiciones
+// precalculadas
+void* countSortDistribuir(void* arg) {
+    CountSortData* data = static_cast<CountSortData*>(arg);
+    AmbitoTraza traza("countsort:distribuir", data->end - data->start);
+    CountSortCompartido* c = data->compartido;
+    const int* input = c->input;
+    int* output = c->output;
+    size_t* posiciones = c->histogramas + data->id * c->paso_histograma;
+    
+    if (c->indices != nullptr) {
+        for (size_t i = data->start; i < data->end; ++i) {
+            int val = input[i];
+            size_t pos = posiciones[val - c->min_val]++;
+            output[pos] = val;
+            c->indices[pos] = static_cast<IndiceOrden>(i);
+        }
+        return nullptr;
+    }
+    
+    for (size_t i = data->start; i < data->end; ++i) {
+        int val = input[i];
+        output[posiciones[val - c->min_val]++] = val;
+    }
+    
+    return nullptr;
+}
+
+// Ejecuta una fase fork-join: un hilo por elemento de thread_data
+template <typename Data>
+void ejecutarFaseParalela(Data* thread_data, size_t num_hilos, void* (*fase)(void*), pthread_t* threads) {
+    {
+        AmbitoTraza traza("fase:crear hilos", num_hilos);
+        for (size_t i = 0; i < num_hilos; ++i) {
+            pthread_create(&threads[i], nullptr, fase, &thread_data[i]);
+        }
+    }
+    
+    AmbitoTraza traza("fase:unir hilos", num_hilos);
+    for (size_t i = 0; i < num_hilos; ++i) {
+        pthread_join(threads[i], nullptr);
+    }
+}
+
+template <typename Data>
+void ejecutarFaseParalela(std::vector<Data>& thread_data, void* (*fase)(void*)) {
+    std::vector<pthread_t> threads(thread_data.size());
+    ejecutarFaseParalela(thread_data.data(), thread_data.size(), fase, threads.data());
+}
+
+// Mínimo y máximo de las claves de un count sort
+struct RangoClaves {
+    int minimo;
+    int maximo;
+    
+    unsigned long long cubetas() const {
+        return static_cast<unsigned long long>(static_cast<long long>(maximo) - minimo) + 1;
+    }
+};
+
+// Reparte la entrada en num_threads trozos contiguos
+void repartirTrozosCountSort(CountSortData* thread_data, int num_threads, size_t n, CountSortCompartido* compartido) {
+    size_t chunk_size = n / num_threads;
+    for (int i = 0; i < num_threads; ++i) {
+        thread_data[i].compartido = compartido;
+        thread_data[i].id = i;
+        thread_data[i].start = i * chunk_size;
+        thread_data[i].end = (i == num_threads - 1) ? n : (i + 1) * chunk_size;
+    }
+}
+
+// Fase 1 completa: mínimo y máximo de toda la entrada (n > 0) en paralelo
+RangoClaves countSortRango(const int* input, size_t n, int num_threads, Arena& arena) {
+    AmbitoArena ambito(arena);
+    num_threads = static_cast<int>(std::min<size_t>(num_threads, n));
+    
+    CountSortCompartido compartido;
+    compartido.input = input;
+    CountSortData* thread_data = arena.reservar<CountSortData>(num_threads);
+    pthread_t* threads = arena.reservar<pthread_t>(num_threads);
+    repartirTrozosCountSort(thread_data, num_threads, n, &compartido);
+    
+    ejecutarFaseParalela(thread_data, num_threads, countSortMinMax, threads);
+    
+    RangoClaves rango{thread_data[0].local_min, thread_data[0].local_max};
+    for (int i = 0; i < num_threads; ++i) {
+        rango.minimo = std::min(rango.minimo, thread_data[i].local_min);
+        rango.maximo = std::max(rango.maximo, thread_data[i].local_max);
+    }
+    return rango;
+}
+
+// Núcleo del count sort paralelo: output (e indices, si no es nulo) tienen n
+// elementos. Si el llamador ya conoce el rango de las claves (rango no nulo)
+// se omite la fase 1. Todo el espacio de trabajo sale de la arena y se
+// devuelve al terminar, así que las llamadas repetidas no reservan memoria.
+void countSortParaleloNucleo(const int* input, size_t n, int* output, IndiceOrden* indices,
+                             int num_threads, Arena& arena, const RangoClaves* rango = nullptr) {
+    if (n == 0) return;
+    
+    AmbitoArena ambito(arena);
+    num_threads = static_cast<int>(std::min<size_t>(num_threads, n));
+    
+    RangoClaves rango_claves = rango != nullptr ? *rango : countSortRango(input, n, num_threads, arena);
+    
+    CountSortCompartido compartido;
+    compartido.input = input;
+    compartido.output = output;
+    compartido.indices = indices;
+    compartido.num_trozos = num_threads;
+    compartido.min_val = rango_claves.minimo;
+    compartido.range = static_cast<size_t>(rango_claves.cubetas());
+    
+    CountSortData* thread_data = arena.reservar<CountSortData>(num_threads);
+    pthread_t* threads = arena.reservar<pthread_t>(num_threads);
+    repartirTrozosCountSort(thread_data, num_threads, n, &compartido);
+    
+    // Filas de histograma alineadas a línea de caché: ningún hilo comparte
+    // línea con el siguiente
+    constexpr size_t CONTADORES_POR_LINEA = 64 / sizeof(size_t);
+    compartido.paso_histograma = (compartido.range + CONTADORES_POR_LINEA - 1) / CONTADORES_POR_LINEA * CONTADORES_POR_LINEA;
+    compartido.histogramas = arena.reservar<size_t>(compartido.paso_histograma * num_threads);
+    
+    ejecutarFaseParalela(thread_data, num_threads, countSortHistograma, threads);
+    
+    countSortPrefijo(compartido, num_threads, arena);
+    ejecutarFaseParalela(thread_data, num_threads, countSortDistribuir, threads);
+}
+
+// Versión con salida y espacio de trabajo del llamador
+void countSortParalelo(const int* input, size_t n, int* output, int num_threads, Arena& arena) {
+    countSortParaleloNucleo(input, n, output, nullptr, num_threads, arena);
+}
+
+std::vector<int> countSortParalelo(const std::vector<int>& input, int num_threads) {
+    std::vector<int> output(input.size());
+    Arena& arena = arenaDelHilo();
+    countSortParaleloNucleo(input.data(), input.size(), output.data(), nullptr, num_threads, arena);
+    return output;
+}
+
+void countSortSecuencial(const int* input, size_t n, int* output, Arena& arena) {
+    if (n == 0) return;
+    
+    AmbitoArena ambito(arena);
+    int min_val = *std::min_element(input, input + n);
+    int max_val = *std::max_element(input, input + n);
+    int range = max_val - min_val + 1;
+    
+    int* count = arena.reservar<int>(range);
+    std::fill(count, count + range, 0);
+    
+    // Contar elementos
+    for (size_t i = 0; i < n; ++i) {
+        count[input[i] - min_val]++;
+    }
+    
+    // Calcular posiciones acumulativas
+    escaneoInclusivo(count, count, range, 1);
+    
+    // Colocar elementos en sus posiciones correctas
+    for (size_t i = n; i-- > 0;) {
+        int val = input[i];
+        int pos = --count[val - min_val];
+        output[pos] = val;
+    }
+}
+
+std::vector<int> countSortSecuencial(const std::vector<int>& input) {
+    std::vector<int> output(input.size());
+    Arena& arena = arenaDelHilo();
+    countSortSecuencial(input.data(), input.size(), output.data(), arena);
+    return output;
+}
+
+void ejecutarCountSort() {
+    std::cout << "\n=== 4. COUNT SORT PARALELO ===" << std::endl;
+    
+    const int ARRAY_SIZE = 100000000; // 100 millones de elementos
+    const int NUM_THREADS = 8;
+    
+    // Generar arreglo de prueba
+    std::vector<int> input(ARRAY_SIZE);
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> dis(1, 10000);
+    
+    for (int i = 0; i < ARRAY_SIZE; ++i) {
+        input[i] = dis(gen);
+    }
+    
+    std::cout << "Tamaño del arreglo: " << ARRAY_SIZE << " elementos" << std::endl;
+    std::cout << "Rango de valores: 1 - 10000" << std::endl;
+    
+    // Verificar que el arreglo no esté ordenado
+    bool ordenado = std::is_sorted(input.begin(), input.end());
+    std::cout << "Arreglo original ordenado: " << (ordenado ? "Sí" : "No") << std::endl;
+    
+    // Medir versión secuencial
+    auto start = std::chrono::high_resolution_clock::now();
+    auto resultado_secuencial = countSortSecuencial(input);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto tiempo_secuencial = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    
+    // Medir versión paralela
+    start = std::chrono::high_resolution_clock::now();
+    auto resultado_paralelo = countSortParalelo(input, NUM_THREADS);
+    end = std::chrono::high_resolution_clock::now();
+    auto tiempo_paralelo = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    
+    // Verificar resultados
+    bool correcto = (resultado_secuencial == resultado_paralelo);
+    bool ordenado_secuencial = std::is_sorted(resultado_secuencial.begin(), resultado_secuencial.end());
+    bool ordenado_paralelo = std::is_sorted(resultado_paralelo.begin(), resultado_paralelo.end());
+    
+    std::cout << "Resultado correcto: " << (correcto ? "✓" : "✗") << std::endl;
+    std::cout << "Secuencial ordenado: " << (ordenado_secuencial ? "✓" : "✗") << std::endl;
+    std::cout << "Paralelo ordenado:   " << (ordenado_paralelo ? "✓" : "✗") << std::endl;
+    
+    // Análisis de rendimiento
+    double speedup = static_cast<double>(tiempo_secuencial.count()) / tiempo_paralelo.count();
+    double eficiencia = speedup / NUM_THREADS;
+    
+    std::cout << "Tiempo secuencial: " << tiempo_secuencial.count() << " ms" << std::endl;
+    std::cout << "Tiempo paralelo:   " << tiempo_paralelo.count() << " ms" << std::endl;
+    std::cout << "Speedup: " << speedup << "x" << std::endl;
+    std::cout << "Eficiencia: " << (eficiencia * 100) << "%" << std::endl;
+    
+    // Escalabilidad con el número de hilos
+    std::cout << "\nEscalabilidad del count sort paralelo:" << std::endl;
+    double ms_un_hilo = 0.0;
+    for (int hilos = 1; hilos <= NUM_THREADS; hilos *= 2) {
+        start = std::chrono::high_resolution_clock::now();
+        auto resultado = countSortParalelo(input, hilos);
+        end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (hilos == 1) {
+            ms_un_hilo = ms;
+        }
+        
+        std::cout << std::setw(4) << hilos << " hilos: " << std::fixed << std::setprecision(1)
+                  << std::setw(8) << ms << " ms  speedup " << std::setprecision(2) << ms_un_hilo / ms << "x"
+                  << (resultado == resultado_secuencial ? "  ✓" : "  ✗") << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// ----------------------------------------------------------------------------
+// Radix sort LSD paralelo y selección automática del algoritmo
+// ----------------------------------------------------------------------------
+
+// Convierte la clave en un entero sin signo con el mismo orden: en los tipos
+// con signo basta invertir el bit de signo
+template <typename K>
+struct ClaveRadix {
+    using Bits = std::make_unsigned_t<K>;
+    static constexpr int BITS = sizeof(K) * 8;
+
+    static Bits bits(K clave) {
+        Bits b = static_cast<Bits>(clave);
+        if constexpr (std::is_signed_v<K>) {
+            b ^= Bits(1) << (BITS - 1);
+        }
+        return b;
+    }
+};
+
+template <typename K>
+struct RadixSortCompartido {
+    const K* origen;
+    K* destino;
+    const IndiceOrden* indices_origen; // Sólo en modo clave-valor
+    IndiceOrden* indices_destino;
+    int desplazamiento;
+    size_t num_cubetas;
+    size_t* histogramas; // Fila t: num_cubetas contadores del hilo t
+};
+
+// Claves que caben en una línea de 128 bytes del buffer de escritura
+// combinada
+template <typename K>
+constexpr size_t TAM_BUFFER_RADIX = 128 / sizeof(K);
+
+template <typename K>
+struct RadixSortData {
+    RadixSortCompartido<K>* compartido;
+    int id;
+    size_t start, end;
+    K* buffer;                   // num_cubetas líneas de TAM_BUFFER_RADIX claves
+    IndiceOrden* buffer_indices; // Ídem para los índices, sólo en modo clave-valor
+    unsigned* llenos;            // Claves pendientes en cada línea
+};
+
+template <typename K>
+inline size_t digitoRadix(K clave, int desplazamiento, size_t num_cubetas) {
+    return (ClaveRadix<K>::bits(clave) >> desplazamiento) & (num_cubetas - 1);
+}
+
+template <typename K>
+void* radixSortHistograma(void* arg) {
+    RadixSortData<K>* data = static_cast<RadixSortData<K>*>(arg);
+    AmbitoTraza traza("radix:histograma", data->end - data->start);
+    RadixSortCompartido<K>* c = data->compartido;
+    size_t* histograma = c->histogramas + data->id * c->num_cubetas;
+
+    std::fill(histograma, histograma + c->num_cubetas, 0);
+    for (size_t i = data->start; i < data->end; ++i) {
+        histograma[digitoRadix(c->origen[i], c->desplazamiento, c->num_cubetas)]++;
+    }
+
+    return nullptr;
+}
+
+// Distribución con buffers de escritura combinada: cada cubeta acumula unas
+// pocas claves en un buffer local y se vuelcan juntas a la salida, de modo
+// que cada escritura a memoria ocupa líneas de caché completas. Con
+// CON_INDICES los índices viajan en un segundo buffer paralelo (SoA).
+template <typename K, bool CON_INDICES>
+void* radixSortDistribuir(void* arg) {
+    RadixSortData<K>* data = static_cast<RadixSortData<K>*>(arg);
+    AmbitoTraza traza("radix:distribuir", data->end - data->start);
+    RadixSortCompartido<K>* c = data->compartido;
+    constexpr size_t TAM_BUFFER = TAM_BUFFER_RADIX<K>;
+
+    K* buffer = data->buffer;
+    IndiceOrden* buffer_indices = data->buffer_indices;
+    unsigned* llenos = data->llenos;
+    size_t* posiciones = c->histogramas + data->id * c->num_cubetas;
+    std::fill(llenos, llenos + c->num_cubetas, 0);
+
+    for (size_t i = data->start; i < data->end; ++i) {
+        K clave = c->origen[i];
+        size_t d = digitoRadix(clave, c->desplazamiento, c->num_cubetas);
+        K* linea = &buffer[d * TAM_BUFFER];
+        if constexpr (CON_INDICES) {
+            buffer_indices[d * TAM_BUFFER + llenos[d]] = c->indices_origen[i];
+        }
+        linea[llenos[d]++] = clave;
+        if (llenos[d] == TAM_BUFFER) {
+            std::copy(linea, linea + TAM_BUFFER, c->destino + posiciones[d]);
+            if constexpr (CON_INDICES) {
+                const IndiceOrden* linea_indices = &buffer_indices[d * TAM_BUFFER];
+                std::copy(linea_indices, linea_indices + TAM_BUFFER, c->indices_destino + posiciones[d]);
+            }
+            posiciones[d] += TAM_BUFFER;
+            llenos[d] = 0;
+        }
+    }
+
+    for (size_t d = 0; d < c->num_cubetas; ++d) {
+        std::copy(&buffer[d * TAM_BUFFER], &buffer[d * TAM_BUFFER] + llenos[d], c->destino + posiciones[d]);
+        if constexpr (CON_INDICES) {
+            std::copy(&buffer_indices[d * TAM_BUFFER], &buffer_indices[d * TAM_BUFFER] + llenos[d],
+                      c->indices_destino + posiciones[d]);
+        }
+    }
+
+    return nullptr;
+}
+
+// Radix sort LSD paralelo en el sitio para claves enteras de 32 o 64 bits
+// con o sin signo. bits_digito suele ser 8 (256 cubetas) u 11 (2048
+// cubetas). Si indices no es nulo se permuta junto con las claves; como
+// cada pasada es estable, el resultado también lo es. El arreglo auxiliar,
+// los histogramas y los buffers de escritura salen de la arena.
+template <typename K>
+void radixSortParaleloNucleo(K* datos, IndiceOrden* indices, size_t n, int num_threads, int bits_digito,
+                             Arena& arena) {
+    static_assert(std::is_integral_v<K>, "radixSortParalelo requiere claves enteras");
+    if (n == 0) return;
+
+    AmbitoArena ambito(arena);
+    num_threads = static_cast<int>(std::min<size_t>(num_threads, n));
+    K* a = datos;
+    K* b = arena.reservar<K>(n);
+    IndiceOrden* indices_a = indices;
+    IndiceOrden* indices_b = indices != nullptr ? arena.reservar<IndiceOrden>(n) : nullptr;
+
+    RadixSortCompartido<K> compartido;
+    compartido.num_cubetas = size_t(1) << bits_digito;
+    compartido.histogramas = arena.reservar<size_t>(compartido.num_cubetas * num_threads);
+
+    RadixSortData<K>* thread_data = arena.reservar<RadixSortData<K>>(num_threads);
+    pthread_t* threads = arena.reservar<pthread_t>(num_threads);
+    size_t lineas = compartido.num_cubetas * TAM_BUFFER_RADIX<K>;
+    size_t chunk_size = n / num_threads;
+    for (int i = 0; i < num_threads; ++i) {
+        thread_data[i].compartido = &compartido;
+        thread_data[i].id = i;
+        thread_data[i].start = i * chunk_size;
+        thread_data[i].end = (i == num_threads - 1) ? n : (i + 1) * chunk_size;
+        thread_data[i].buffer = arena.reservar<K>(lineas);
+        thread_data[i].buffer_indices = indices != nullptr ? arena.reservar<IndiceOrden>(lineas) : nullptr;
+        thread_data[i].llenos = arena.reservar<unsigned>(compartido.num_cubetas);
+    }
+
+    for (int desplazamiento = 0; desplazamiento < ClaveRadix<K>::BITS; desplazamiento += bits_digito) {
+        compartido.origen = a;
+        compartido.destino = b;
+        compartido.indices_origen = indices_a;
+        compartido.indices_destino = indices_b;
+        compartido.desplazamiento = desplazamiento;
+
+        ejecutarFaseParalela(thread_data, num_threads, radixSortHistograma<K>, threads);
+
+        // Si todas las claves comparten este dígito la pasada no cambia nada
+        bool digito_constante = false;
+        for (size_t d = 0; d < compartido.num_cubetas && !digito_constante; ++d) {
+            size_t total = 0;
+            for (int t = 0; t < num_threads; ++t) {
+                total += compartido.histogramas[t * compartido.num_cubetas + d];
+            }
+            digito_constante = (total == n);
+        }
+        if (digito_constante) {
+            continue;
+        }
+
+        // Posición de salida de cada (dígito, hilo), recorriendo por dígitos
+        size_t acumulado = 0;
+        for (size_t d = 0; d < compartido.num_cubetas; ++d) {
+            for (int t = 0; t < num_threads; ++t) {
+                size_t& celda = compartido.histogramas[t * compartido.num_cubetas + d];
+                size_t cantidad = celda;
+                celda = acumulado;
+                acumulado += cantidad;
+            }
+        }
+
+        if (indices != nullptr) {
+            ejecutarFaseParalela(thread_data, num_threads, radixSortDistribuir<K, true>, threads);
+            std::swap(indices_a, indices_b);
+        } else {
+            ejecutarFaseParalela(thread_data, num_threads, radixSortDistribuir<K, false>, threads);
+        }
+        std::swap(a, b);
+    }
+
+    // Con un número impar de pasadas el resultado quedó en el auxiliar
+    if (a != datos) {
+        std::copy(a, a + n, datos);
+        if (indices != nullptr) {
+            std::copy(indices_a, indices_a + n, indices);
+        }
+    }
+}
+
+// Versión con salida y espacio de trabajo del llamador; output puede ser
+// el propio input
+template <typename K>
+void radixSortParalelo(const K* input, size_t n, K* output, int num_threads, Arena& arena, int bits_digito = 8) {
+    if (output != input) {
+        std::copy(input, input + n, output);
+    }
+    radixSortParaleloNucleo(output, nullptr, n, num_threads, bits_digito, arena);
+}
+
+template <typename K>
+std::vector<K> radixSortParalelo(const std::vector<K>& input, int num_threads, int bits_digito = 8) {
+    std::vector<K> a(input);
+    Arena& arena = arenaDelHilo();
+    radixSortParaleloNucleo(a.data(), nullptr, a.size(), num_threads, bits_digito, arena);
+    return a;
+}
+
+template <typename K>
+struct OrdenarTrozoData {
+    K* datos;
+    size_t start, end;
+};
+
+template <typename K>
+void* ordenarTrozo(void* arg) {
+    OrdenarTrozoData<K>* data = static_cast<OrdenarTrozoData<K>*>(arg);
+    AmbitoTraza traza("comparacion:ordenar trozo", data->end - data->start);
+    std::sort(data->datos + data->start, data->datos + data->end);
+    return nullptr;
+}
+
+template <typename K>
+struct MezclarTrozosData {
+    const K* origen;
+    K* destino;
+    size_t start, medio, end;
+};
+
+template <typename K>
+void* mezclarTrozos(void* arg) {
+    MezclarTrozosData<K>* data = static_cast<MezclarTrozosData<K>*>(arg);
+    AmbitoTraza traza("comparacion:mezclar", data->end - data->start);
+    std::merge(data->origen + data->start, data->origen + data->medio,
+               data->origen + data->medio, data->origen + data->end,
+               data->destino + data->start);
+    return nullptr;
+}
+
+// std::sort paralelo por comparación: cada hilo ordena un trozo y después
+// se mezclan los trozos por parejas, también en paralelo
+template <typename K>
+std::vector<K> ordenarComparacionParalelo(const std::vector<K>& input, int num_threads) {
+    size_t n = input.size();
+    std::vector<K> a(input);
+    if (n < 2) return a;
+    num_threads = static_cast<int>(std::min<size_t>(num_threads, n));
+
+    std::vector<size_t> limites(num_threads + 1);
+    for (int i = 0; i <= num_threads; ++i) {
+        limites[i] = (i == num_threads) ? n : i * (n / num_threads);
+    }
+
+    std::vector<OrdenarTrozoData<K>> trozos(num_threads);
+    for (int i = 0; i < num_threads; ++i) {
+        trozos[i] = {a.data(), limites[i], limites[i + 1]};
+    }
+    ejecutarFaseParalela(trozos, ordenarTrozo<K>);
+
+    std::vector<K> b(n);
+    for (size_t ancho = 1; ancho < static_cast<size_t>(num_threads); ancho *= 2) {
+        std::vector<MezclarTrozosData<K>> mezclas;
+        for (size_t i = 0; i < static_cast<size_t>(num_threads); i += 2 * ancho) {
+            size_t medio = std::min(i + ancho, static_cast<size_t>(num_threads));
+            size_t fin = std::min(i + 2 * ancho, static_cast<size_t>(num_threads));
+            mezclas.push_back({a.data(), b.data(), limites[i], limites[medio], limites[fin]});
+        }
+        ejecutarFaseParalela(mezclas, mezclarTrozos<K>);
+        a.swap(b);
+    }
+
+    return a;
+}
+
+enum class AlgoritmoOrdenamiento { COUNT_SORT, RADIX_SORT, COMPARACION };
+
+const char* nombreAlgoritmo(AlgoritmoOrdenamiento algoritmo) {
+    switch (algoritmo) {
+        case AlgoritmoOrdenamiento::COUNT_SORT: return "count sort";
+        case AlgoritmoOrdenamiento::RADIX_SORT: return "radix sort";
+        default: return "comparación";
+    }
+}
+
+// Elige el algoritmo a partir del tamaño y del rango observado: el count sort
+// sólo compensa si sus histogramas (uno por hilo) no superan la entrada, y
+// con pocos elementos un ordenamiento por comparación es más barato. El
+// rango de una muestra nunca supera al real, así que basta para descartar el
+// count sort sin recorrer la entrada; si sigue siendo candidato, el rango
+// exacto sale de su propia fase 1 en paralelo y se devuelve en `rango` para
+// que el count sort no la repita.
+template <typename K>
+AlgoritmoOrdenamiento elegirOrdenamiento(const K* input, size_t n, int num_threads, Arena& arena,
+                                         RangoClaves& rango) {
+    const size_t MINIMO_DISTRIBUCION = 1 << 14;
+    if (n < MINIMO_DISTRIBUCION) {
+        return AlgoritmoOrdenamiento::COMPARACION;
+    }
+
+    if constexpr (std::is_same_v<K, int>) {
+        const size_t MUESTRAS = 1024;
+        const size_t paso = n / MUESTRAS;
+        RangoClaves muestra{input[0], input[0]};
+        for (size_t i = 0; i < MUESTRAS; ++i) {
+            muestra.minimo = std::min(muestra.minimo, input[i * paso]);
+            muestra.maximo = std::max(muestra.maximo, input[i * paso]);
+        }
+        if (muestra.cubetas() * num_threads > n) {
+            return AlgoritmoOrdenamiento::RADIX_SORT;
+        }
+
+        rango = countSortRango(input, n, num_threads, arena);
+        if (rango.cubetas() * num_threads <= n) {
+            return AlgoritmoOrdenamiento::COUNT_SORT;
+        }
+    } else {
+        (void)arena;
+        (void)rango;
+    }
+    return AlgoritmoOrdenamiento::RADIX_SORT;
+}
+
+// Versión con salida y espacio de trabajo del llamador
+template <typename K>
+void ordenarParalelo(const K* input, size_t n, K* output, int num_threads, Arena& arena,
+                     AlgoritmoOrdenamiento* elegido = nullptr) {
+    RangoClaves rango;
+    AlgoritmoOrdenamiento algoritmo = elegirOrdenamiento(input, n, num_threads, arena, rango);
+    if (elegido != nullptr) {
+        *elegido = algoritmo;
+    }
+
+    switch (algoritmo) {
+        case AlgoritmoOrdenamiento::COUNT_SORT:
+            if constexpr (std::is_same_v<K, int>) {
+                countSortParaleloNucleo(input, n, output, nullptr, num_threads, arena, &rango);
+                return;
+            }
+            [[fallthrough]];
+        case AlgoritmoOrdenamiento::RADIX_SORT:
+            radixSortParalelo(input, n, output, num_threads, arena, 11);
+            return;
+        default:
+            std::copy(input, input + n, output);
+            std::sort(output, output + n);
+            return;
+    }
+}
+
+template <typename K>
+std::vector<K> ordenarParalelo(const std::vector<K>& input, int num_threads, AlgoritmoOrdenamiento* elegido = nullptr) {
+    std::vector<K> resultado(input.size());
+    Arena& arena = arenaDelHilo();
+    ordenarParalelo(input.data(), input.size(), resultado.data(), num_threads, arena, elegido);
+    return resultado;
+}
+
+// Resultado del ordenamiento clave-valor: las claves ordenadas y, para cada
+// posición, el índice que ocupaba esa clave en la entrada
+template <typename K>
+struct OrdenClaveValor {
+    std::vector<K> claves;
+    std::vector<IndiceOrden> permutacion;
+};
+
+// Ordenamiento clave-valor estable (claves e índices en arreglos separados)
+// sobre la misma maquinaria que ordenarParalelo: count sort con rango corto,
+// radix sort LSD en otro caso y, con pocos elementos, std::sort de índices
+// desempatando por posición. claves_ordenadas y permutacion tienen n
+// elementos.
+template <typename K>
+void ordenarClaveValorParalelo(const K* claves, size_t n, K* claves_ordenadas, IndiceOrden* permutacion,
+                               int num_threads, Arena& arena, AlgoritmoOrdenamiento* elegido = nullptr) {
+    if (n > std::numeric_limits<IndiceOrden>::max()) {
+        throw std::length_error("ordenarClaveValorParalelo: demasiados elementos para IndiceOrden");
+    }
+
+    RangoClaves rango;
+    AlgoritmoOrdenamiento algoritmo = elegirOrdenamiento(claves, n, num_threads, arena, rango);
+    if (elegido != nullptr) {
+        *elegido = algoritmo;
+    }
+
+    switch (algoritmo) {
+        case AlgoritmoOrdenamiento::COUNT_SORT:
+            if constexpr (std::is_same_v<K, int>) {
+                countSortParaleloNucleo(claves, n, claves_ordenadas, permutacion, num_threads, arena, &rango);
+                return;
+            }
+            [[fallthrough]];
+        case AlgoritmoOrdenamiento::RADIX_SORT:
+            std::copy(claves, claves + n, claves_ordenadas);
+            std::iota(permutacion, permutacion + n, IndiceOrden(0));
+            radixSortParaleloNucleo(claves_ordenadas, permutacion, n, num_threads, 11, arena);
+            return;
+        default:
+            std::iota(permutacion, permutacion + n, IndiceOrden(0));
+            std::sort(permutacion, permutacion + n, [claves](IndiceOrden a, IndiceOrden b) {
+                return claves[a] < claves[b] || (claves[a] == claves[b] && a < b);
+            });
+            for (size_t i = 0; i < n; ++i) {
+                claves_ordenadas[i] = claves[permutacion[i]];
+            }
+            return;
+    }
+}
+
+template <typename K>
+OrdenClaveValor<K> ordenarClaveValorParalelo(const std::vector<K>& claves, int num_threads,
+                                             AlgoritmoOrdenamiento* elegido = nullptr) {
+    OrdenClaveValor<K> resultado;
+    resultado.claves.resize(claves.size());
+    resultado.permutacion.resize(claves.size());
+    Arena& arena = arenaDelHilo();
+    ordenarClaveValorParalelo(claves.data(), claves.size(), resultado.claves.data(), resultado.permutacion.data(),
+                              num_threads, arena, elegido);
+    return resultado;
+}
+
+// Argsort estable: permutacion[k] es el índice en la entrada de la k-ésima
+// clave más pequeña
+template <typename K>
+std::vector<IndiceOrden> argsortParalelo(const std::vector<K>& claves, int num_threads) {
+    return ordenarClaveValorParalelo(claves, num_threads).permutacion;
+}
+
+template <typename... Columnas>
+struct PermutarColumnasData {
+    const IndiceOrden* permutacion;
+    std::tuple<Columnas*...> origen;
+    std::tuple<Columnas*...> destino;
+    size_t start, end;
+};
+
+template <typename... Columnas, size_t... I>
+inline void moverFila(PermutarColumnasData<Columnas...>* data, size_t i, std::index_sequence<I...>) {
+    size_t j = data->permutacion[i];
+    ((std::get<I>(data->destino)[i] = std::move(std::get<I>(data->origen)[j])), ...);
+}
+
+template <typename... Columnas>
+void* permutarColumnasTrozo(void* arg) {
+    PermutarColumnasData<Columnas...>* data = static_cast<PermutarColumnasData<Columnas...>*>(arg);
+    AmbitoTraza traza("clave-valor:permutar columnas", data->end - data->start);
+    for (size_t i = data->start; i < data->end; ++i) {
+        moverFila(data, i, std::index_sequence_for<Columnas...>{});
+    }
+    return nullptr;
+}
+
+// Reordena varias columnas de carga útil en una sola pasada sobre la
+// permutación: columna[k] pasa a ser la antigua columna[permutacion[k]].
+// Los elementos se mueven, no se copian.
+template <typename... Columnas>
+void permutarColumnasParalelo(const std::vector<IndiceOrden>& permutacion, int num_threads,
+                              std::vector<Columnas>&... columnas) {
+    size_t n = permutacion.size();
+    if (n == 0) return;
+    num_threads = static_cast<int>(std::min<size_t>(num_threads, n));
+
+    std::tuple<std::vector<Columnas>...> destinos{std::vector<Columnas>(n)...};
+    std::tuple<Columnas*...> punteros_destino =
+        std::apply([](auto&... destino) { return std::tuple<Columnas*...>(destino.data()...); }, destinos);
+
+    std::vector<PermutarColumnasData<Columnas...>> thread_data(num_threads);
+    size_t chunk_size = n / num_threads;
+    for (int i = 0; i < num_threads; ++i) {
+        thread_data[i].permutacion = permutacion.data();
+        thread_data[i].origen = std::tuple<Columnas*...>(columnas.data()...);
+        thread_data[i].destino = punteros_destino;
+        thread_data[i].start = i * chunk_size;
+        thread_data[i].end = (i == num_threads - 1) ? n : (i + 1) * chunk_size;
+    }
+    ejecutarFaseParalela(thread_data, permutarColumnasTrozo<Columnas...>);
+
+    std::apply([&](auto&... destino) { (columnas.swap(destino), ...); }, destinos);
+}
+
+// Ordena las claves en el sitio y arrastra con ellas las columnas de carga
+// útil (estable)
+template <typename K, typename... Columnas>
+void ordenarPorClaveParalelo(std::vector<K>& claves, int num_threads, std::vector<Columnas>&... columnas) {
+    OrdenClaveValor<K> orden = ordenarClaveValorParalelo(claves, num_threads);
+    claves.swap(orden.claves);
+    permutarColumnasParalelo(orden.permutacion, num_threads, columnas...);
+}
+
+template <typename K>
+void compararOrdenamientos(const char* nombre, const std::vector<K>& input, int num_threads) {
+    auto medir = [](auto&& ordenar, std::vector<K>& resultado) {
+        auto start = std::chrono::high_resolution_clock::now();
+        resultado = ordenar();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+
+    std::vector<K> referencia, resultado;
+    double ms_std = medir([&] {
+        std::vector<K> copia(input);
+        std::sort(copia.begin(), copia.end());
+        return copia;
+    }, referencia);
+
+    bool correcto = true;
+    double ms_std_paralelo = medir([&] { return ordenarComparacionParalelo(input, num_threads); }, resultado);
+    correcto = correcto && resultado == referencia;
+    double ms_radix8 = medir([&] { return radixSortParalelo(input, num_threads, 8); }, resultado);
+    correcto = correcto && resultado == referencia;
+    double ms_radix11 = medir([&] { return radixSortParalelo(input, num_threads, 11); }, resultado);
+    correcto = correcto && resultado == referencia;
+    AlgoritmoOrdenamiento elegido;
+    double ms_auto = medir([&] { return ordenarParalelo(input, num_threads, &elegido); }, resultado);
+    correcto = correcto && resultado == referencia;
+
+    std::cout << std::left << std::setw(24) << nombre << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << ms_std << std::setw(16) << ms_std_paralelo
+              << std::setw(10) << ms_radix8 << std::setw(10) << ms_radix11
+              << std::setw(10) << ms_auto << "  " << std::left << std::setw(12) << nombreAlgoritmo(elegido)
+              << std::right << (correcto ? "✓" : "✗") << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+void ejecutarComparacionOrdenamientos() {
+    std::cout << "\nRadix sort LSD paralelo y selección automática" << std::endl;
+
+    const size_t ARRAY_SIZE = 10000000;
+    const int NUM_THREADS = 8;
+    std::mt19937_64 gen(7);
+
+    std::vector<int> enteros_32(ARRAY_SIZE);
+    std::vector<unsigned> naturales_32(ARRAY_SIZE);
+    std::vector<long long> enteros_64(ARRAY_SIZE);
+    std::vector<unsigned long long> naturales_64(ARRAY_SIZE);
+    std::vector<int> rango_corto(ARRAY_SIZE);
+    std::uniform_int_distribution<> dis_corto(1, 10000);
+    for (size_t i = 0; i < ARRAY_SIZE; ++i) {
+        unsigned long long r = gen();
+        enteros_32[i] = static_cast<int>(r);
+        naturales_32[i] = static_cast<unsigned>(r >> 32);
+        enteros_64[i] = static_cast<long long>(gen());
+        naturales_64[i] = gen();
+        rango_corto[i] = dis_corto(gen);
+    }
+
+    std::cout << "Tamaño: " << ARRAY_SIZE << " elementos, " << NUM_THREADS << " hilos (tiempos en ms)" << std::endl;
+    std::cout << std::left << std::setw(24) << "Claves" << std::right
+              << std::setw(12) << "std::sort" << std::setw(16) << "std::sort par."
+              << std::setw(10) << "radix 8" << std::setw(10) << "radix 11"
+              << std::setw(10) << "auto" << "  " << "elegido" << std::endl;
+
+    compararOrdenamientos("int32 rango completo", enteros_32, NUM_THREADS);
+    compararOrdenamientos("uint32 rango completo", naturales_32, NUM_THREADS);
+    compararOrdenamientos("int64 rango completo", enteros_64, NUM_THREADS);
+    compararOrdenamientos("uint64 rango completo", naturales_64, NUM_THREADS);
+    compararOrdenamientos("int32 en [1, 10000]", rango_corto, NUM_THREADS);
+}
+
+// Registro en formato AoS para la referencia con std::stable_sort
+struct RegistroOrden {
+    int clave;
+    std::string nombre;
+    double valor;
+};
+
+void ejecutarOrdenamientoClaveValor() {
+    std::cout << "\nOrdenamiento clave-valor y argsort" << std::endl;
+
+    const size_t NUM_REGISTROS = 2000000;
+    const int NUM_THREADS = 8;
+    std::mt19937_64 gen(13);
+    std::uniform_int_distribution<> dis_corto(1, 10000);
+
+    std::vector<RegistroOrden> registros(NUM_REGISTROS);
+    std::vector<int> claves(NUM_REGISTROS);
+    std::vector<std::string> nombres(NUM_REGISTROS);
+    std::vector<double> valores(NUM_REGISTROS);
+    std::vector<int> claves_cortas(NUM_REGISTROS);
+    for (size_t i = 0; i < NUM_REGISTROS; ++i) {
+        claves[i] = static_cast<int>(gen());
+        nombres[i] = "registro-numero-" + std::to_string(i);
+        valores[i] = static_cast<double>(i) * 0.5;
+        registros[i] = {claves[i], nombres[i], valores[i]};
+        claves_cortas[i] = dis_corto(gen);
+    }
+
+    std::cout << "Registros: " << NUM_REGISTROS << " (clave int32, nombre string, valor double), "
+              << NUM_THREADS << " hilos" << std::endl;
+
+    // Referencia: registros AoS ordenados por clave con std::stable_sort
+    auto start = std::chrono::high_resolution_clock::now();
+    std::stable_sort(registros.begin(), registros.end(),
+                     [](const RegistroOrden& a, const RegistroOrden& b) { return a.clave < b.clave; });
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms_referencia = std::chrono::duration<double, std::milli>(end - start).count();
+
+    // Columnas SoA: se ordenan las claves y se mueven nombres y valores en
+    // una sola pasada
+    start = std::chrono::high_resolution_clock::now();
+    ordenarPorClaveParalelo(claves, NUM_THREADS, nombres, valores);
+    end = std::chrono::high_resolution_clock::now();
+    double ms_clave_valor = std::chrono::duration<double, std::milli>(end - start).count();
+
+    bool correcto = true;
+    for (size_t i = 0; i < NUM_REGISTROS && correcto; ++i) {
+        correcto = claves[i] == registros[i].clave && nombres[i] == registros[i].nombre &&
+                   valores[i] == registros[i].valor;
+    }
+
+    // Argsort con claves de rango corto (camino del count sort)
+    std::vector<IndiceOrden> referencia_indices(NUM_REGISTROS);
+    std::iota(referencia_indices.begin(), referencia_indices.end(), IndiceOrden(0));
+    start = std::chrono::high_resolution_clock::now();
+    std::stable_sort(referencia_indices.begin(), referencia_indices.end(),
+                     [&](IndiceOrden a, IndiceOrden b) { return claves_cortas[a] < claves_cortas[b]; });
+    end = std::chrono::high_resolution_clock::now();
+    double ms_argsort_referencia = std::chrono::duration<double, std::milli>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<IndiceOrden> indices = argsortParalelo(claves_cortas, NUM_THREADS);
+    end = std::chrono::high_resolution_clock::now();
+    double ms_argsort = std::chrono::duration<double, std::milli>(end - start).count();
+    bool argsort_correcto = indices == referencia_indices;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "std::stable_sort de registros AoS:      " << ms_referencia << " ms" << std::endl;
+    std::cout << "ordenarPorClaveParalelo (SoA, 2 cols):  " << ms_clave_valor << " ms  "
+              << (correcto ? "✓" : "✗") << std::endl;
+    std::cout << "std::stable_sort de índices [1, 10000]: " << ms_argsort_referencia << " ms" << std::endl;
+    std::cout << "argsortParalelo [1, 10000]:             " << ms_argsort << " ms  "
+              << (argsort_correcto ? "✓" : "✗") << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// Compara un escaneo de escaneo_paralelo.h con el bucle secuencial de
+// referencia y lo mide con los dos backends
+template <typename Escanear>
+void compararEscaneo(const char* nombre, const std::vector<long long>& referencia, Escanear escanear) {
+    std::vector<long long> salida(referencia.size());
+    std::cout << std::left << std::setw(26) << nombre << std::right << std::fixed << std::setprecision(1);
+    bool correcto = true;
+    for (BackendEscaneo backend : {BackendEscaneo::PTHREAD, BackendEscaneo::OPENMP}) {
+        std::fill(salida.begin(), salida.end(), 0);
+        auto start = std::chrono::high_resolution_clock::now();
+        escanear(salida.data(), backend);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << std::setw(12) << std::chrono::duration<double, std::milli>(end - start).count();
+        correcto = correcto && salida == referencia;
+    }
+    std::cout << "  " << (correcto ? "✓" : "✗") << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+void ejecutarEscaneoParalelo() {
+    std::cout << "\nEscaneo paralelo (escaneo_paralelo.h)" << std::endl;
+
+    const size_t ARRAY_SIZE = 50000000;
+    const int NUM_THREADS = 8;
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<> dis(-1000, 1000);
+    std::bernoulli_distribution nuevo_segmento(0.001);
+
+    std::vector<long long> datos(ARRAY_SIZE);
+    std::vector<unsigned char> inicios(ARRAY_SIZE);
+    for (size_t i = 0; i < ARRAY_SIZE; ++i) {
+        datos[i] = dis(gen);
+        inicios[i] = nuevo_segmento(gen);
+    }
+
+    // Referencias secuenciales
+    std::vector<long long> inclusivo(ARRAY_SIZE), exclusivo(ARRAY_SIZE), maximo(ARRAY_SIZE), segmentado(ARRAY_SIZE);
+    auto start = std::chrono::high_resolution_clock::now();
+    long long acumulado = 0;
+    for (size_t i = 0; i < ARRAY_SIZE; ++i) {
+        acumulado += datos[i];
+        inclusivo[i] = acumulado;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms_secuencial = std::chrono::duration<double, std::milli>(end - start).count();
+
+    acumulado = 0;
+    long long mayor = std::numeric_limits<long long>::min();
+    long long en_segmento = 0;
+    for (size_t i = 0; i < ARRAY_SIZE; ++i) {
+        exclusivo[i] = acumulado;
+        acumulado += datos[i];
+        mayor = std::max(mayor, datos[i]);
+        maximo[i] = mayor;
+        if (inicios[i]) en_segmento = 0;
+        en_segmento += datos[i];
+        segmentado[i] = en_segmento;
+    }
+
+    std::cout << "Tamaño: " << ARRAY_SIZE << " elementos, " << NUM_THREADS << " hilos (tiempos en ms)" << std::endl;
+    std::cout << "Suma inclusiva secuencial: " << std::fixed << std::setprecision(1) << ms_secuencial << " ms" << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+    std::cout << std::left << std::setw(26) << "Escaneo" << std::right
+              << std::setw(12) << "pthread" << std::setw(12) << "OpenMP" << std::endl;
+
+    compararEscaneo("suma inclusiva", inclusivo, [&](long long* salida, BackendEscaneo backend) {
+        escaneoInclusivo(datos.data(), salida, ARRAY_SIZE, NUM_THREADS, std::plus<long long>(), 0LL, backend);
+    });
+    compararEscaneo("suma exclusiva", exclusivo, [&](long long* salida, BackendEscaneo backend) {
+        escaneoExclusivo(datos.data(), salida, ARRAY_SIZE, NUM_THREADS, std::plus<long long>(), 0LL, backend);
+    });
+    compararEscaneo("máximo inclusivo", maximo, [&](long long* salida, BackendEscaneo backend) {
+        escaneoInclusivo(datos.data(), salida, ARRAY_SIZE, NUM_THREADS,
+                         [](long long a, long long b) { return std::max(a, b); },
+                         std::numeric_limits<long long>::min(), backend);
+    });
+    compararEscaneo("suma segmentada", segmentado, [&](long long* salida, BackendEscaneo backend) {
+        escaneoSegmentado(datos.data(), inicios.data(), salida, ARRAY_SIZE, NUM_THREADS, true,
+                          std::plus<long long>(), 0LL, backend);
+    });
+}
+
+// ============================================================================
+// 5. PIPELINE PARALELO MULTI-ETAPA
+// ============================================================================
+
+// Cada elemento que circula entre etapas lleva su número de secuencia para
+// que las etapas que preservan el orden puedan reordenar su salida.
+template <typename T>
+struct ElementoSecuenciado {
+    size_t secuencia;
+    T valor;
+};
+
+// Recoge los elementos que produce una etapa al procesar una entrada
+template <typename T>
+class Emisor {
+public:
+    void emitir(T&& valor) {
+        pendientes.push_back(std::move(valor));
+    }
+
+    std::vector<T> pendientes;
+};
+
+// Lado de salida de una etapa: cola acotada hacia la etapa siguiente más la
+// ventana de reordenamiento usada cuando la etapa preserva el orden.
+template <typename T>
+class SalidaEtapa {
+private:
+    BufferProductorConsumidor<ElementoSecuenciado<T>> cola;
+    size_t capacidad;
+    std::atomic<size_t> siguiente_secuencia;
+    std::mutex mutex_orden;
+    std::map<size_t, std::vector<T>> fuera_de_orden;
+    size_t siguiente_entrada;
+
+public:
+    explicit SalidaEtapa(size_t capacidad)
+        : cola(capacidad), capacidad(capacidad), siguiente_secuencia(0), siguiente_entrada(0) {}
+
+    void enviar(T&& valor) {
+        cola.producir({siguiente_secuencia++, std::move(valor)});
+    }
+
+    // Publica los resultados de la entrada `secuencia` cuando ya se publicaron
+    // todos los de las entradas anteriores; si no, quedan en espera
+    void enviarEnOrden(size_t secuencia, std::vector<T>&& valores) {
+        std::lock_guard<std::mutex> lock(mutex_orden);
+        fuera_de_orden.emplace(secuencia, std::move(valores));
+
+        while (!fuera_de_orden.empty() && fuera_de_orden.begin()->first == siguiente_entrada) {
+            for (T& valor : fuera_de_orden.begin()->second) {
+                enviar(std::move(valor));
+            }
+            fuera_de_orden.erase(fuera_de_orden.begin());
+            ++siguiente_entrada;
+        }
+    }
+
+    bool recibir(ElementoSecuenciado<T>& elemento) {
+        return cola.consumir(elemento);
+    }
+
+    void terminar() {
+        cola.terminar();
+    }
+
+    size_t ocupacion() const {
+        return cola.size();
+    }
+
+    size_t getCapacidad() const {
+        return capacidad;
+    }
+};
+
+// Parte común de todas las etapas: hilos, terminación y estadísticas
+class EtapaPipeline {
+protected:
+    std::string nombre;
+    int num_hilos;
+    std::vector<pthread_t> hilos;
+    std::atomic<int> hilos_activos;
+    std::atomic<bool> terminada;
+
+    std::atomic<long long> procesados;
+    std::atomic<long long> tiempo_ocupado_ns;
+    std::chrono::high_resolution_clock::time_point inicio;
+    std::chrono::high_resolution_clock::time_point fin;
+
+    long long muestras_ocupacion;
+    long long suma_ocupacion;
+    size_t max_ocupacion;
+
+    virtual void trabajar() = 0;
+    virtual void finalizar() = 0;
+
+    void registrarTrabajo(std::chrono::high_resolution_clock::time_point desde, long long elementos = 1) {
+        auto hasta = std::chrono::high_resolution_clock::now();
+        tiempo_ocupado_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(hasta - desde).count();
+        procesados += elementos;
+    }
+
+private:
+    static void* hiloEtapa(void* arg) {
+        EtapaPipeline* etapa = static_cast<EtapaPipeline*>(arg);
+        {
+            AmbitoTraza traza("pipeline:etapa");
+            etapa->trabajar();
+        }
+
+        // El último hilo en salir cierra la cola de salida de la etapa
+        if (--etapa->hilos_activos == 0) {
+            etapa->finalizar();
+            etapa->fin = std::chrono::high_resolution_clock::now();
+            etapa->terminada = true;
+        }
+        return nullptr;
+    }
+
+public:
+    EtapaPipeline(const std::string& nombre, int num_hilos)
+        : nombre(nombre), num_hilos(num_hilos), hilos(num_hilos), hilos_activos(0),
+          terminada(false), procesados(0), tiempo_ocupado_ns(0),
+          muestras_ocupacion(0), suma_ocupacion(0), max_ocupacion(0) {}
+
+    virtual ~EtapaPipeline() = default;
+
+    void lanzar() {
+        inicio = std::chrono::high_resolution_clock::now();
+        hilos_activos = num_hilos;
+        AmbitoTraza traza("pipeline:crear hilos", num_hilos);
+        for (int i = 0; i < num_hilos; ++i) {
+            pthread_create(&hilos[i], nullptr, hiloEtapa, this);
+        }
+    }
+
+    void esperar() {
+        AmbitoTraza traza("pipeline:unir hilos", num_hilos);
+        for (int i = 0; i < num_hilos; ++i) {
+            pthread_join(hilos[i], nullptr);
+        }
+    }
+
+    bool estaTerminada() const {
+        return terminada;
+    }
+
+    // Ocupación y capacidad de la cola de salida (0 para el sumidero)
+    virtual size_t ocupacionSalida() const = 0;
+    virtual size_t capacidadSalida() const = 0;
+
+    void muestrearOcupacion() {
+        size_t ocupacion = ocupacionSalida();
+        ++muestras_ocupacion;
+        suma_ocupacion += ocupacion;
+        max_ocupacion = std::max(max_ocupacion, ocupacion);
+    }
+
+    const std::string& getNombre() const { return nombre; }
+    int getNumHilos() const { return num_hilos; }
+    long long getProcesados() const { return procesados; }
+
+    double segundosActiva() const {
+        return std::chrono::duration<double>(fin - inicio).count();
+    }
+
+    // Fracción del tiempo de la etapa que sus hilos pasan trabajando (no
+    // esperando en colas): la etapa más cercana a 1 es el cuello de botella
+    double utilizacion() const {
+        double disponible = segundosActiva() * num_hilos;
+        return disponible > 0 ? (tiempo_ocupado_ns / 1e9) / disponible : 0.0;
+    }
+
+    double ocupacionMedia() const {
+        return muestras_ocupacion > 0 ? static_cast<double>(suma_ocupacion) / muestras_ocupacion : 0.0;
+    }
+
+    size_t ocupacionMaxima() const {
+        return max_ocupacion;
+    }
+};
+
+template <typename Salida>
+class EtapaConSalida : public EtapaPipeline {
+protected:
+    SalidaEtapa<Salida> salida;
+
+public:
+    EtapaConSalida(const std::string& nombre, int num_hilos, size_t capacidad)
+        : EtapaPipeline(nombre, num_hilos), salida(capacidad) {}
+
+    SalidaEtapa<Salida>& getSalida() { return salida; }
+
+    size_t ocupacionSalida() const override { return salida.ocupacion(); }
+    size_t capacidadSalida() const override { return salida.getCapacidad(); }
+};
+
+// Genera elementos hasta que la función devuelve false
+template <typename Salida>
+class EtapaFuente : public EtapaConSalida<Salida> {
+public:
+    using Generador = std::function<bool(int hilo, Emisor<Salida>&)>;
+
+    EtapaFuente(const std::string& nombre, int num_hilos, size_t capacidad, Generador generador)
+        : EtapaConSalida<Salida>(nombre, num_hilos, capacidad), generador(std::move(generador)),
+          siguiente_hilo(0) {}
+
+protected:
+    void trabajar() override {
+        int hilo = siguiente_hilo++;
+        bool continuar = true;
+        while (continuar) {
+            auto desde = std::chrono::high_resolution_clock::now();
+            Emisor<Salida> emisor;
+            continuar = generador(hilo, emisor);
+            this->registrarTrabajo(desde, emisor.pendientes.size());
+            for (Salida& valor : emisor.pendientes) {
+                this->salida.enviar(std::move(valor));
+            }
+        }
+    }
+
+    void finalizar() override {
+        this->salida.terminar();
+    }
+
+private:
+    Generador generador;
+    std::atomic<int> siguiente_hilo;
+};
+
+// Transforma cada entrada en cero o más salidas; opcionalmente conserva el
+// orden de las entradas y ejecuta un paso final cuando se agota la entrada
+template <typename Entrada, typename Salida>
+class EtapaProcesamiento : public EtapaConSalida<Salida> {
+public:
+    using Funcion = std::function<void(Entrada&&, Emisor<Salida>&)>;
+    using Finalizador = std::function<void(Emisor<Salida>&)>;
+
+    EtapaProcesamiento(const std::string& nombre, int num_hilos, size_t capacidad,
+                       SalidaEtapa<Entrada>* entrada, bool preservar_orden,
+                       Funcion funcion, Finalizador finalizador)
+        : EtapaConSalida<Salida>(nombre, num_hilos, capacidad), entrada(entrada),
+          preservar_orden(preservar_orden), funcion(std::move(funcion)),
+          finalizador(std::move(finalizador)) {}
+
+protected:
+    void trabajar() override {
+        ElementoSecuenciado<Entrada> elemento;
+        while (entrada->recibir(elemento)) {
+            auto desde = std::chrono::high_resolution_clock::now();
+            Emisor<Salida> emisor;
+            funcion(std::move(elemento.valor), emisor);
+            this->registrarTrabajo(desde);
+
+            if (preservar_orden) {
+                this->salida.enviarEnOrden(elemento.secuencia, std::move(emisor.pendientes));
+            } else {
+                for (Salida& valor : emisor.pendientes) {
+                    this->salida.enviar(std::move(valor));
+                }
+            }
+        }
+    }
+
+    void finalizar() override {
+        if (finalizador) {
+            Emisor<Salida> emisor;
+            finalizador(emisor);
+            for (Salida& valor : emisor.pendientes) {
+                this->salida.enviar(std::move(valor));
+            }
+        }
+        this->salida.terminar();
+    }
+
+private:
+    SalidaEtapa<Entrada>* entrada;
+    bool preservar_orden;
+    Funcion funcion;
+    Finalizador finalizador;
+};
+
+// Consume los elementos de la última cola del pipeline
+template <typename Entrada>
+class EtapaSumidero : public EtapaPipeline {
+public:
+    using Funcion = std::function<void(Entrada&&)>;
+
+    EtapaSumidero(const std::string& nombre, int num_hilos, SalidaEtapa<Entrada>* entrada, Funcion funcion)
+        : EtapaPipeline(nombre, num_hilos), entrada(entrada), funcion(std::move(funcion)) {}
+
+    size_t ocupacionSalida() const override { return 0; }
+    size_t capacidadSalida() const override { return 0; }
+
+protected:
+    void trabajar() override {
+        ElementoSecuenciado<Entrada> elemento;
+        while (entrada->recibir(elemento)) {
+            auto desde = std::chrono::high_resolution_clock::now();
+            funcion(std::move(elemento.valor));
+            this->registrarTrabajo(desde);
+        }
+    }
+
+    void finalizar() override {}
+
+private:
+    SalidaEtapa<Entrada>* entrada;
+    Funcion funcion;
+};
+
+// Conjunto de etapas conectadas por colas acotadas. Cada etapa tiene su
+// propio grado de paralelismo; mientras corre, el pipeline muestrea la
+// ocupación de las colas para localizar la etapa cuello de botella.
+class Pipeline {
+private:
+    std::vector<std::unique_ptr<EtapaPipeline>> etapas;
+
+public:
+    template <typename Salida>
+    EtapaFuente<Salida>* agregarFuente(const std::string& nombre, int num_hilos, size_t capacidad,
+                                       typename EtapaFuente<Salida>::Generador generador) {
+        auto etapa = new EtapaFuente<Salida>(nombre, num_hilos, capacidad, std::move(generador));
+        etapas.emplace_back(etapa);
+        return etapa;
+    }
+
+    template <typename Salida, typename Entrada>
+    EtapaProcesamiento<Entrada, Salida>* agregarEtapa(
+        const std::string& nombre, EtapaConSalida<Entrada>* anterior, int num_hilos, size_t capacidad,
+        bool preservar_orden, typename EtapaProcesamiento<Entrada, Salida>::Funcion funcion,
+        typename EtapaProcesamiento<Entrada, Salida>::Finalizador finalizador = nullptr) {
+        auto etapa = new EtapaProcesamiento<Entrada, Salida>(
+            nombre, num_hilos, capacidad, &anterior->getSalida(), preservar_orden,
+            std::move(funcion), std::move(finalizador));
+        etapas.emplace_back(etapa);
+        return etapa;
+    }
+
+    template <typename Entrada>
+    EtapaSumidero<Entrada>* agregarSumidero(const std::string& nombre, EtapaConSalida<Entrada>* anterior,
+                                            int num_hilos, typename EtapaSumidero<Entrada>::Funcion funcion) {
+        auto etapa = new EtapaSumidero<Entrada>(nombre, num_hilos, &anterior->getSalida(), std::move(funcion));
+        etapas.emplace_back(etapa);
+        return etapa;
+    }
+
+    void ejecutar(std::chrono::microseconds intervalo_muestreo = std::chrono::microseconds(500)) {
+        for (auto& etapa : etapas) {
+            etapa->lanzar();
+        }
+
+        bool todas_terminadas = false;
+        while (!todas_terminadas) {
+            todas_terminadas = true;
+            for (auto& etapa : etapas) {
+                etapa->muestrearOcupacion();
+                todas_terminadas = todas_terminadas && etapa->estaTerminada();
+            }
+            std::this_thread::sleep_for(intervalo_muestreo);
+        }
+
+        for (auto& etapa : etapas) {
+            etapa->esperar();
+        }
     }
-    
-    return h * suma;
-}
 
-void ejecutarReglaTrapezoidal() {
-    std::cout << "\n=== 3. REGLA TRAPEZOIDAL (INTEGRACIÓN NUMÉRICA) ===" << std::endl;
-    
-    const double A = 0.0; // Límite inferior
-    const double B = 1.0; // Límite superior
-    const int N = 10000000; // Número de trapecios
-    const int NUM_THREADS = 8;
-    
-    std::cout << "Integrando f(x) = x² desde " << A << " hasta " << B << std::endl;
-    std::cout << "Número de trapecios: " << N << std::endl;
-    std::cout << "Valor teórico: " << (B*B*B - A*A*A) / 3.0 << std::endl;
-    
-    // Medir versión secuencial
+    void imprimirEstadisticas() const {
+        const EtapaPipeline* cuello = nullptr;
+        for (const auto& etapa : etapas) {
+            if (cuello == nullptr || etapa->utilizacion() > cuello->utilizacion()) {
+                cuello = etapa.get();
+            }
+        }
+
+        std::cout << std::left << std::setw(16) << "Etapa" << std::right
+                  << std::setw(6) << "Hilos" << std::setw(12) << "Elementos"
+                  << std::setw(14) << "Elem/sec" << std::setw(10) << "Uso %"
+                  << std::setw(16) << "Cola media/máx" << std::endl;
+
+        for (const auto& etapa : etapas) {
+            double segundos = etapa->segundosActiva();
+            std::ostringstream cola;
+            if (etapa->capacidadSalida() > 0) {
+                cola << std::fixed << std::setprecision(1) << etapa->ocupacionMedia() << "/"
+                     << etapa->ocupacionMaxima() << " de " << etapa->capacidadSalida();
+            } else {
+                cola << "-";
+            }
+
+            std::cout << std::left << std::setw(16) << etapa->getNombre() << std::right
+                      << std::setw(6) << etapa->getNumHilos()
+                      << std::setw(12) << etapa->getProcesados()
+                      << std::setw(14) << std::fixed << std::setprecision(0)
+                      << (segundos > 0 ? etapa->getProcesados() / segundos : 0.0)
+                      << std::setw(10) << std::setprecision(1) << etapa->utilizacion() * 100
+                      << "  " << cola.str() << std::endl;
+        }
+
+        std::cout << "Cuello de botella: " << cuello->getNombre() << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    }
+};
+
+void ejecutarPipeline() {
+    std::cout << "\n=== 5. PIPELINE PARALELO MULTI-ETAPA ===" << std::endl;
+
+    const int NUM_BLOQUES = 64;
+    const int TAM_BLOQUE = 250000;
+    const int BLOQUES_POR_MEZCLA = 8;
+    const int HILOS_ORDENAMIENTO = 4;
+    const size_t CAPACIDAD_COLA = 8;
+
+    std::cout << "generar → count sort por bloque → mezclar → sumar" << std::endl;
+    std::cout << "Bloques: " << NUM_BLOQUES << " de " << TAM_BLOQUE << " elementos" << std::endl;
+
+    std::atomic<long long> suma_generada(0);
+    std::atomic<int> siguiente_bloque(0);
+    long long suma_consumida = 0;
+    long long elementos_consumidos = 0;
+    bool bloques_ordenados = true;
+    std::vector<std::vector<int>> por_mezclar;
+
+    Pipeline pipeline;
+
+    auto generar = pipeline.agregarFuente<std::vector<int>>(
+        "generar", 1, CAPACIDAD_COLA,
+        [&](int, Emisor<std::vector<int>>& emisor) {
+            int bloque = siguiente_bloque++;
+            if (bloque >= NUM_BLOQUES) {
+                return false;
+            }
+            std::mt19937 gen(bloque);
+            std::uniform_int_distribution<> dis(1, 10000);
+            std::vector<int> datos(TAM_BLOQUE);
+            long long suma = 0;
+            for (int& valor : datos) {
+                valor = dis(gen);
+                suma += valor;
+            }
+            suma_generada += suma;
+            emisor.emitir(std::move(datos));
+            return true;
+        });
+
+    auto ordenar = pipeline.agregarEtapa<std::vector<int>>(
+        "count sort", generar, HILOS_ORDENAMIENTO, CAPACIDAD_COLA, true,
+        [](std::vector<int>&& bloque, Emisor<std::vector<int>>& emisor) {
+            emisor.emitir(countSortSecuencial(bloque));
+        });
+
+    // Mezcla por grupos: acumula bloques ordenados y emite un bloque mayor
+    auto mezclarGrupo = [&por_mezclar](Emisor<std::vector<int>>& emisor) {
+        if (por_mezclar.empty()) {
+            return;
+        }
+        std::vector<int> mezclado = std::move(por_mezclar[0]);
+        for (size_t i = 1; i < por_mezclar.size(); ++i) {
+            std::vector<int> destino(mezclado.size() + por_mezclar[i].size());
+            std::merge(mezclado.begin(), mezclado.end(),
+                       por_mezclar[i].begin(), por_mezclar[i].end(), destino.begin());
+            mezclado.swap(destino);
+        }
+        por_mezclar.clear();
+        emisor.emitir(std::move(mezclado));
+    };
+
+    auto mezclar = pipeline.agregarEtapa<std::vector<int>>(
+        "mezclar", ordenar, 1, CAPACIDAD_COLA, false,
+        [&](std::vector<int>&& bloque, Emisor<std::vector<int>>& emisor) {
+            por_mezclar.push_back(std::move(bloque));
+            if (por_mezclar.size() == BLOQUES_POR_MEZCLA) {
+                mezclarGrupo(emisor);
+            }
+        },
+        mezclarGrupo);
+
+    pipeline.agregarSumidero<std::vector<int>>(
+        "sumar", mezclar, 1,
+        [&](std::vector<int>&& bloque) {
+            bloques_ordenados = bloques_ordenados && std::is_sorted(bloque.begin(), bloque.end());
+            for (int valor : bloque) {
+                suma_consumida += valor;
+            }
+            elementos_consumidos += bloque.size();
+        });
+
     auto start = std::chrono::high_resolution_clock::now();
-    double resultado_secuencial = reglaTrapezoidalSecuencial(A, B, N);
+    pipeline.ejecutar();
     auto end = std::chrono::high_resolution_clock::now();
-    auto tiempo_secuencial = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-    
-    // Medir versión paralela
-    start = std::chrono::high_resolution_clock::now();
-    double resultado_paralelo = reglaTrapezoidalParalela(A, B, N, NUM_THREADS);
-    end = std::chrono::high_resolution_clock::now();
-    auto tiempo_paralelo = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-    
-    std::cout << "Resultado secuencial: " << std::fixed << std::setprecision(10) << resultado_secuencial << std::endl;
-    std::cout << "Resultado paralelo:   " << resultado_paralelo << std::endl;
-    
-    // Análisis de rendimiento
-    double speedup = static_cast<double>(tiempo_secuencial.count()) / tiempo_paralelo.count();
-    double eficiencia = speedup / NUM_THREADS;
-    
-    std::cout << "Tiempo secuencial: " << tiempo_secuencial.count() << " ms" << std::endl;
-    std::cout << "Tiempo paralelo:   " << tiempo_paralelo.count() << " ms" << std::endl;
-    std::cout << "Speedup: " << speedup << "x" << std::endl;
-    std::cout << "Eficiencia: " << (eficiencia * 100) << "%" << std::endl;
+    auto tiempo = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+    bool correcto = suma_consumida == suma_generada &&
+                    elementos_consumidos == static_cast<long long>(NUM_BLOQUES) * TAM_BLOQUE;
+    std::cout << "Resultado correcto: " << (correcto ? "✓" : "✗") << std::endl;
+    std::cout << "Bloques mezclados ordenados: " << (bloques_ordenados ? "✓" : "✗") << std::endl;
+    std::cout << "Tiempo total: " << tiempo.count() << " ms" << std::endl;
+    pipeline.imprimirEstadisticas();
 }
 
 // ============================================================================
-// 4. COUNT SORT PARALELO
+// 6. MÉTODOS ITERATIVOS (POTENCIA, JACOBI, GRADIENTE CONJUGADO)
 // ============================================================================
 
-struct CountSortData {
-    const std::vector<int>* input;
-    std::vector<int>* output;
-    std::vector<int>* count;
-    int start_val, end_val;
-    int min_val;
+enum class MetodoIterativo { POTENCIA, JACOBI, GRADIENTE_CONJUGADO };
+
+// Resultado parcial de un hilo en una línea de caché propia. Hay dos ranuras
+// que se alternan entre fases para que ningún hilo sobrescriba un parcial que
+// otro todavía está leyendo.
+struct alignas(64) ParcialHilo {
+    double valor[2];
 };
 
-void* countSortParcial(void* arg) {
-    CountSortData* data = static_cast<CountSortData*>(arg);
-    
-    // Contar elementos en el rango asignado
-    for (int val : *data->input) {
-        if (val >= data->start_val && val < data->end_val) {
-            (*data->count)[val - data->min_val]++;
+// Estado compartido por todos los hilos durante toda la resolución: los hilos
+// se crean una sola vez y se sincronizan con barreras en cada iteración. Los
+// vectores de trabajo salen de la arena de quien resuelve.
+struct RegionIterativa {
+    MetodoIterativo metodo;
+    const std::vector<std::vector<double>>* A;
+    const std::vector<double>* b;
+    double* x[2]; // Iterado con doble buffer
+    double* r;    // r, p y q sólo los usa el gradiente conjugado
+    double* p;
+    double* q;
+    ParcialHilo* parciales;
+    BarreraHilos barrera;
+    int num_threads;
+    double tolerancia;
+    int max_iteraciones;
+
+    // Escritos por el hilo 0 al terminar
+    int iteraciones;
+    double valor;
+    bool convergio;
+    int buffer_final;
+
+    RegionIterativa(int num_threads) : x{nullptr, nullptr}, r(nullptr), p(nullptr), q(nullptr), parciales(nullptr),
+                                       barrera(num_threads), num_threads(num_threads),
+                                       iteraciones(0), valor(0), convergio(false), buffer_final(0) {}
+
+    // Todos los hilos suman los parciales en el mismo orden, así que todos
+    // obtienen el mismo valor y toman la misma decisión sin otra barrera
+    double reducir(int ranura) const {
+        double total = 0.0;
+        for (int t = 0; t < num_threads; ++t) {
+            total += parciales[t].valor[ranura];
         }
+        return total;
+    }
+};
+
+struct IterativoData {
+    RegionIterativa* region;
+    int id;
+    int start_row;
+    int end_row;
+};
+
+// Iteración de potencia: y = A·x / ||x||. La normalización se aplica al
+// calcular la siguiente iteración, así que basta una barrera por iteración.
+void* iterarPotencia(void* arg) {
+    IterativoData* data = static_cast<IterativoData*>(arg);
+    RegionIterativa& region = *data->region;
+    const auto& A = *region.A;
+    size_t n = A.size();
+
+    int actual = 0;
+    double inv_norma = 1.0;
+    double lambda = 0.0;
+    double lambda_anterior = 0.0;
+    bool convergio = false;
+    int it = 0;
+
+    while (it < region.max_iteraciones && !convergio) {
+        int siguiente = 1 - actual;
+        int ranura = it & 1;
+        double parcial = 0.0;
+
+        for (int i = data->start_row; i < data->end_row; ++i) {
+            double y = productoPunto(A[i].data(), region.x[actual], n) * inv_norma;
+            region.x[siguiente][i] = y;
+            parcial += y * y;
+        }
+        region.parciales[data->id].valor[ranura] = parcial;
+        {
+            AmbitoTraza traza("iterativo:barrera");
+            region.barrera.esperar();
+        }
+
+        lambda = std::sqrt(region.reducir(ranura));
+        inv_norma = 1.0 / lambda;
+        actual = siguiente;
+        ++it;
+        convergio = std::abs(lambda - lambda_anterior) < region.tolerancia * lambda;
+        lambda_anterior = lambda;
+    }
+
+    if (data->id == 0) {
+        region.iteraciones = it;
+        region.valor = lambda;
+        region.convergio = convergio;
+        region.buffer_final = actual;
     }
-    
     return nullptr;
 }
 
-std::vector<int> countSortParalelo(const std::vector<int>& input, int num_threads) {
-    if (input.empty()) return {};
-    
-    int min_val = *std::min_element(input.begin(), input.end());
-    int max_val = *std::max_element(input.begin(), input.end());
-    int range = max_val - min_val + 1;
-    
-    std::vector<int> output(input.size());
-    std::vector<int> count(range, 0);
-    
-    std::vector<pthread_t> threads(num_threads);
-    std::vector<CountSortData> thread_data(num_threads);
-    
-    int chunk_size = range / num_threads;
-    
-    // Crear y lanzar hilos para contar
-    for (int i = 0; i < num_threads; ++i) {
-        thread_data[i].input = &input;
-        thread_data[i].output = &output;
-        thread_data[i].count = &count;
-        thread_data[i].start_val = min_val + i * chunk_size;
-        thread_data[i].end_val = (i == num_threads - 1) ? max_val + 1 : min_val + (i + 1) * chunk_size;
-        thread_data[i].min_val = min_val;
-        
-        pthread_create(&threads[i], nullptr, countSortParcial, &thread_data[i]);
+// Jacobi: x' = D⁻¹(b - (A - D)x). La norma del cambio se acumula en el mismo
+// recorrido que calcula x'.
+void* iterarJacobi(void* arg) {
+    IterativoData* data = static_cast<IterativoData*>(arg);
+    RegionIterativa& region = *data->region;
+    const auto& A = *region.A;
+    const auto& b = *region.b;
+    size_t n = A.size();
+
+    int actual = 0;
+    double delta = 0.0;
+    bool convergio = false;
+    int it = 0;
+
+    while (it < region.max_iteraciones && !convergio) {
+        int siguiente = 1 - actual;
+        int ranura = it & 1;
+        const double* x = region.x[actual];
+        double parcial = 0.0;
+
+        for (int i = data->start_row; i < data->end_row; ++i) {
+            const std::vector<double>& fila = A[i];
+            double fuera_diagonal = productoPunto(fila.data(), x, n) - fila[i] * x[i];
+            double nuevo = (b[i] - fuera_diagonal) / fila[i];
+            double cambio = nuevo - x[i];
+            region.x[siguiente][i] = nuevo;
+            parcial += cambio * cambio;
+        }
+        region.parciales[data->id].valor[ranura] = parcial;
+        {
+            AmbitoTraza traza("iterativo:barrera");
+            region.barrera.esperar();
+        }
+
+        delta = std::sqrt(region.reducir(ranura));
+        actual = siguiente;
+        ++it;
+        convergio = delta < region.tolerancia;
     }
-    
-    // Esperar a que todos los hilos terminen
-    for (int i = 0; i < num_threads; ++i) {
-        pthread_join(threads[i], nullptr);
+
+    if (data->id == 0) {
+        region.iteraciones = it;
+        region.valor = delta;
+        region.convergio = convergio;
+        region.buffer_final = actual;
     }
-    
-    // Calcular posiciones acumulativas
-    for (int i = 1; i < range; ++i) {
-        count[i] += count[i - 1];
+    return nullptr;
+}
+
+// Gradiente conjugado con dos barreras por iteración. Como p' = r + βp, se
+// usa A·p' = A·r + β(A·p) para que cada hilo actualice p y q sólo en sus
+// filas sin esperar a que los demás terminen de escribir p.
+void* iterarGradienteConjugado(void* arg) {
+    IterativoData* data = static_cast<IterativoData*>(arg);
+    RegionIterativa& region = *data->region;
+    const auto& A = *region.A;
+    size_t n = A.size();
+    double* x = region.x[0];
+    double* r = region.r;
+    double* p = region.p;
+    double* q = region.q;
+
+    double rr = region.valor; // r·r inicial, calculado por quien lanza los hilos
+    double norma_b = std::sqrt(rr);
+    double beta = 0.0;
+    bool convergio = false;
+    int fase = 0;
+    int it = 0;
+
+    while (it < region.max_iteraciones && !convergio) {
+        double parcial = 0.0;
+        for (int i = data->start_row; i < data->end_row; ++i) {
+            p[i] = r[i] + beta * p[i];
+            q[i] = productoPunto(A[i].data(), r, n) + beta * q[i];
+            parcial += p[i] * q[i];
+        }
+        region.parciales[data->id].valor[fase & 1] = parcial;
+        {
+            AmbitoTraza traza("iterativo:barrera");
+            region.barrera.esperar();
+        }
+        double alpha = rr / region.reducir(fase & 1);
+        ++fase;
+
+        parcial = 0.0;
+        for (int i = data->start_row; i < data->end_row; ++i) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * q[i];
+            parcial += r[i] * r[i];
+        }
+        region.parciales[data->id].valor[fase & 1] = parcial;
+        {
+            AmbitoTraza traza("iterativo:barrera");
+            region.barrera.esperar();
+        }
+        double rr_nuevo = region.reducir(fase & 1);
+        ++fase;
+
+        ++it;
+        convergio = std::sqrt(rr_nuevo) < region.tolerancia * norma_b;
+        beta = rr_nuevo / rr;
+        rr = rr_nuevo;
     }
-    
-    // Colocar elementos en sus posiciones correctas
-    for (int i = input.size() - 1; i >= 0; --i) {
-        int val = input[i];
-        int pos = --count[val - min_val];
-        output[pos] = val;
+
+    if (data->id == 0) {
+        region.iteraciones = it;
+        region.valor = std::sqrt(rr);
+        region.convergio = convergio;
+        region.buffer_final = 0;
     }
-    
-    return output;
+    return nullptr;
 }
 
-std::vector<int> countSortSecuencial(const std::vector<int>& input) {
-    if (input.empty()) return {};
-    
-    int min_val = *std::min_element(input.begin(), input.end());
-    int max_val = *std::max_element(input.begin(), input.end());
-    int range = max_val - min_val + 1;
-    
-    std::vector<int> count(range, 0);
-    std::vector<int> output(input.size());
-    
-    // Contar elementos
-    for (int val : input) {
-        count[val - min_val]++;
+struct ResultadoIterativo {
+    std::vector<double> x;
+    double valor;      // Autovalor (potencia), último cambio (Jacobi) o residuo (CG)
+    int iteraciones;
+    bool convergio;
+    double segundos;
+};
+
+// Versión con salida y espacio de trabajo del llamador: la solución se
+// escribe en `solucion` (A.size() elementos) y resultado.x queda vacío. Los
+// iterados, los vectores del gradiente conjugado, los parciales y los
+// descriptores de hilo salen de la arena.
+ResultadoIterativo resolverIterativo(MetodoIterativo metodo,
+                                     const std::vector<std::vector<double>>& A,
+                                     const std::vector<double>& b,
+                                     double tolerancia, int max_iteraciones, int num_threads,
+                                     double* solucion, Arena& arena) {
+    int n = A.size();
+    AmbitoArena ambito(arena);
+    RegionIterativa region(num_threads);
+    region.metodo = metodo;
+    region.A = &A;
+    region.b = &b;
+    region.tolerancia = tolerancia;
+    region.max_iteraciones = max_iteraciones;
+    region.x[0] = arena.reservar<double>(n);
+    region.x[1] = arena.reservar<double>(n);
+    std::fill(region.x[0], region.x[0] + n, 0.0);
+    std::fill(region.x[1], region.x[1] + n, 0.0);
+    region.parciales = arena.reservar<ParcialHilo>(num_threads);
+
+    void* (*funcion)(void*) = nullptr;
+    switch (metodo) {
+        case MetodoIterativo::POTENCIA:
+            std::fill(region.x[0], region.x[0] + n, 1.0 / std::sqrt(static_cast<double>(n)));
+            funcion = iterarPotencia;
+            break;
+        case MetodoIterativo::JACOBI:
+            funcion = iterarJacobi;
+            break;
+        case MetodoIterativo::GRADIENTE_CONJUGADO:
+            region.r = arena.reservar<double>(n);
+            region.p = arena.reservar<double>(n);
+            region.q = arena.reservar<double>(n);
+            std::copy(b.begin(), b.end(), region.r);
+            std::fill(region.p, region.p + n, 0.0);
+            std::fill(region.q, region.q + n, 0.0);
+            region.valor = productoPunto(b.data(), b.data(), n);
+            funcion = iterarGradienteConjugado;
+            break;
     }
-    
-    // Calcular posiciones acumulativas
-    for (int i = 1; i < range; ++i) {
-        count[i] += count[i - 1];
+
+    pthread_t* threads = arena.reservar<pthread_t>(num_threads);
+    IterativoData* thread_data = arena.reservar<IterativoData>(num_threads);
+    int chunk_size = n / num_threads;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    {
+        AmbitoTraza traza("iterativo:crear hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            thread_data[i].region = &region;
+            thread_data[i].id = i;
+            thread_data[i].start_row = i * chunk_size;
+            thread_data[i].end_row = (i == num_threads - 1) ? n : (i + 1) * chunk_size;
+
+            pthread_create(&threads[i], nullptr, funcion, &thread_data[i]);
+        }
     }
-    
-    // Colocar elementos en sus posiciones correctas
-    for (int i = input.size() - 1; i >= 0; --i) {
-        int val = input[i];
-        int pos = --count[val - min_val];
-        output[pos] = val;
+
+    {
+        AmbitoTraza traza("iterativo:unir hilos", num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            pthread_join(threads[i], nullptr);
+        }
     }
-    
-    return output;
+    auto end = std::chrono::high_resolution_clock::now();
+
+    ResultadoIterativo resultado;
+    resultado.valor = region.valor;
+    resultado.iteraciones = region.iteraciones;
+    resultado.convergio = region.convergio;
+    resultado.segundos = std::chrono::duration<double>(end - start).count();
+
+    const double* final = region.x[region.buffer_final];
+    double escala = metodo == MetodoIterativo::POTENCIA ? 1.0 / resultado.valor : 1.0;
+    for (int i = 0; i < n; ++i) {
+        solucion[i] = final[i] * escala;
+    }
+    return resultado;
 }
 
-void ejecutarCountSort() {
-    std::cout << "\n=== 4. COUNT SORT PARALELO ===" << std::endl;
-    
-    const int ARRAY_SIZE = 1000000; // 1 millón de elementos
+ResultadoIterativo resolverIterativo(MetodoIterativo metodo,
+                                     const std::vector<std::vector<double>>& A,
+                                     const std::vector<double>& b,
+                                     double tolerancia, int max_iteraciones, int num_threads) {
+    std::vector<double> x(A.size());
+    ResultadoIterativo resultado = resolverIterativo(metodo, A, b, tolerancia, max_iteraciones, num_threads,
+                                                     x.data(), arenaDelHilo());
+    resultado.x = std::move(x);
+    return resultado;
+}
+
+// Iteración de potencia llamando a multiplicarMatrizVectorParalelo en cada
+// paso: crea y une los hilos y reserva el vector resultado cada vez
+ResultadoIterativo potenciaConLlamadas(const std::vector<std::vector<double>>& A,
+                                       double tolerancia, int max_iteraciones, int num_threads) {
+    int n = A.size();
+    std::vector<double> x(n, 1.0 / std::sqrt(static_cast<double>(n)));
+    double lambda = 0.0;
+    double lambda_anterior = 0.0;
+    bool convergio = false;
+    int it = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    while (it < max_iteraciones && !convergio) {
+        std::vector<double> y = multiplicarMatrizVectorParalelo(A, x, num_threads);
+        lambda = std::sqrt(productoPunto(y.data(), y.data(), n));
+        for (int i = 0; i < n; ++i) {
+            x[i] = y[i] / lambda;
+        }
+        ++it;
+        convergio = std::abs(lambda - lambda_anterior) < tolerancia * lambda;
+        lambda_anterior = lambda;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return {x, lambda, it, convergio, std::chrono::duration<double>(end - start).count()};
+}
+
+double residuo(const std::vector<std::vector<double>>& A, const std::vector<double>& x,
+               const std::vector<double>& b) {
+    double suma = 0.0;
+    for (size_t i = 0; i < A.size(); ++i) {
+        double d = productoPunto(A[i].data(), x.data(), x.size()) - b[i];
+        suma += d * d;
+    }
+    return std::sqrt(suma);
+}
+
+void ejecutarMetodosIterativos() {
+    std::cout << "\n=== 6. MÉTODOS ITERATIVOS (POTENCIA, JACOBI, GRADIENTE CONJUGADO) ===" << std::endl;
+
+    const int N = 2000;
     const int NUM_THREADS = 8;
-    
-    // Generar arreglo de prueba
-    std::vector<int> input(ARRAY_SIZE);
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(1, 10000);
-    
-    for (int i = 0; i < ARRAY_SIZE; ++i) {
-        input[i] = dis(gen);
+    const int MAX_ITERACIONES = 1000;
+    const double TOLERANCIA = 1e-10;
+
+    // Matriz simétrica y diagonalmente dominante: Jacobi y CG convergen
+    std::vector<std::vector<double>> A(N, std::vector<double>(N));
+    std::vector<double> b(N);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> dis(0.0, 1.0);
+
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < i; ++j) {
+            A[i][j] = A[j][i] = dis(gen);
+        }
+        A[i][i] = N;
+        b[i] = dis(gen);
     }
-    
-    std::cout << "Tamaño del arreglo: " << ARRAY_SIZE << " elementos" << std::endl;
-    std::cout << "Rango de valores: 1 - 10000" << std::endl;
-    
-    // Verificar que el arreglo no esté ordenado
-    bool ordenado = std::is_sorted(input.begin(), input.end());
-    std::cout << "Arreglo original ordenado: " << (ordenado ? "Sí" : "No") << std::endl;
-    
-    // Medir versión secuencial
+
+    std::cout << "Matriz: " << N << " x " << N << " (simétrica, diagonalmente dominante)" << std::endl;
+    std::cout << "Hilos persistentes: " << NUM_THREADS << ", tolerancia: " << TOLERANCIA << std::endl;
+
+    auto reportar = [](const std::string& nombre, const ResultadoIterativo& res, const std::string& verificacion) {
+        std::cout << std::left << std::setw(30) << nombre << std::right
+                  << " iteraciones: " << std::setw(4) << res.iteraciones
+                  << (res.convergio ? " ✓" : " ✗")
+                  << "  tiempo: " << std::fixed << std::setprecision(1) << std::setw(8) << res.segundos * 1000 << " ms"
+                  << "  iter/sec: " << std::setprecision(0) << std::setw(6) << res.iteraciones / res.segundos
+                  << "  " << verificacion << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    };
+
+    auto potencia = resolverIterativo(MetodoIterativo::POTENCIA, A, b, TOLERANCIA, MAX_ITERACIONES, NUM_THREADS);
+    reportar("Potencia (región única)", potencia, "λ = " + std::to_string(potencia.valor));
+
+    auto potencia_llamadas = potenciaConLlamadas(A, TOLERANCIA, MAX_ITERACIONES, NUM_THREADS);
+    reportar("Potencia (hilos por llamada)", potencia_llamadas, "λ = " + std::to_string(potencia_llamadas.valor));
+
+    auto jacobi = resolverIterativo(MetodoIterativo::JACOBI, A, b, TOLERANCIA, MAX_ITERACIONES, NUM_THREADS);
+    reportar("Jacobi", jacobi, "||Ax-b|| = " + std::to_string(residuo(A, jacobi.x, b)));
+
+    auto cg = resolverIterativo(MetodoIterativo::GRADIENTE_CONJUGADO, A, b, TOLERANCIA, MAX_ITERACIONES, NUM_THREADS);
+    reportar("Gradiente conjugado", cg, "||Ax-b|| = " + std::to_string(residuo(A, cg.x, b)));
+
+    std::cout << "Speedup región única vs hilos por llamada (iter/sec): "
+              << (potencia.iteraciones / potencia.segundos) /
+                 (potencia_llamadas.iteraciones / potencia_llamadas.segundos) << "x" << std::endl;
+}
+
+// ============================================================================
+// 7. REUTILIZACIÓN DE MEMORIA ENTRE LLAMADAS
+// ============================================================================
+
+// Mide una llamada repetida con la API que devuelve contenedores nuevos y
+// con la versión de salida y arena. La arena se calienta con la primera
+// llamada; el resto no debe mapear bloques nuevos.
+template <typename Asignando, typename ConArena>
+void compararReutilizacion(const char* nombre, int repeticiones, Arena& arena,
+                           Asignando llamarAsignando, ConArena llamarConArena) {
     auto start = std::chrono::high_resolution_clock::now();
-    auto resultado_secuencial = countSortSecuencial(input);
+    for (int r = 0; r < repeticiones; ++r) {
+        llamarAsignando();
+    }
     auto end = std::chrono::high_resolution_clock::now();
-    auto tiempo_secuencial = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-    
-    // Medir versión paralela
+    double ms_asignando = std::chrono::duration<double, std::milli>(end - start).count() / repeticiones;
+
+    bool correcto = llamarConArena();
+    size_t bloques = arena.numBloques();
     start = std::chrono::high_resolution_clock::now();
-    auto resultado_paralelo = countSortParalelo(input, NUM_THREADS);
+    for (int r = 0; r < repeticiones; ++r) {
+        correcto = llamarConArena() && correcto;
+    }
     end = std::chrono::high_resolution_clock::now();
-    auto tiempo_paralelo = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-    
-    // Verificar resultados
-    bool correcto = (resultado_secuencial == resultado_paralelo);
-    bool ordenado_secuencial = std::is_sorted(resultado_secuencial.begin(), resultado_secuencial.end());
-    bool ordenado_paralelo = std::is_sorted(resultado_paralelo.begin(), resultado_paralelo.end());
-    
-    std::cout << "Resultado correcto: " << (correcto ? "✓" : "✗") << std::endl;
-    std::cout << "Secuencial ordenado: " << (ordenado_secuencial ? "✓" : "✗") << std::endl;
-    std::cout << "Paralelo ordenado:   " << (ordenado_paralelo ? "✓" : "✗") << std::endl;
-    
-    // Análisis de rendimiento
-    double speedup = static_cast<double>(tiempo_secuencial.count()) / tiempo_paralelo.count();
-    double eficiencia = speedup / NUM_THREADS;
-    
-    std::cout << "Tiempo secuencial: " << tiempo_secuencial.count() << " ms" << std::endl;
-    std::cout << "Tiempo paralelo:   " << tiempo_paralelo.count() << " ms" << std::endl;
-    std::cout << "Speedup: " << speedup << "x" << std::endl;
-    std::cout << "Eficiencia: " << (eficiencia * 100) << "%" << std::endl;
+    double ms_arena = std::chrono::duration<double, std::milli>(end - start).count() / repeticiones;
+    bool sin_bloques_nuevos = arena.numBloques() == bloques;
+
+    std::cout << std::left << std::setw(26) << nombre << std::right << std::fixed << std::setprecision(2)
+              << std::setw(14) << ms_asignando << std::setw(12) << ms_arena
+              << std::setw(10) << bloques << "  " << (sin_bloques_nuevos ? "sí" : "no")
+              << "  " << (correcto ? "✓" : "✗") << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+void ejecutarReutilizacionMemoria() {
+    std::cout << "\n=== 7. REUTILIZACIÓN DE MEMORIA ENTRE LLAMADAS ===" << std::endl;
+
+    const int NUM_THREADS = 8;
+    const int REPETICIONES = 20;
+    const size_t N_ORDENAR = 10000000;
+    const int N_MATRIZ = 2000;
+    std::mt19937 gen(17);
+    std::uniform_int_distribution<> dis_corto(1, 10000);
+    std::uniform_int_distribution<> dis(1, 10);
+
+    std::vector<int> claves_cortas(N_ORDENAR), claves(N_ORDENAR);
+    for (size_t i = 0; i < N_ORDENAR; ++i) {
+        claves_cortas[i] = dis_corto(gen);
+        claves[i] = static_cast<int>(gen());
+    }
+    std::vector<std::vector<int>> matriz(N_MATRIZ, std::vector<int>(N_MATRIZ));
+    std::vector<int> vector(N_MATRIZ);
+    for (int i = 0; i < N_MATRIZ; ++i) {
+        vector[i] = dis(gen);
+        for (int j = 0; j < N_MATRIZ; ++j) {
+            matriz[i][j] = dis(gen);
+        }
+    }
+    auto referencia_count = countSortSecuencial(claves_cortas);
+    auto referencia_radix = radixSortParalelo(claves, NUM_THREADS, 11);
+    auto referencia_matvec = multiplicarMatrizVectorSecuencial(matriz, vector);
+
+    // Los resultados también salen de la arena y viven toda la prueba
+    Arena arena;
+    int* salida_orden = arena.reservar<int>(N_ORDENAR);
+    int* salida_matvec = arena.reservar<int>(N_MATRIZ);
+
+    std::cout << REPETICIONES << " llamadas por kernel, " << NUM_THREADS << " hilos (ms por llamada)" << std::endl;
+    std::cout << std::left << std::setw(26) << "Kernel" << std::right << std::setw(14) << "contenedores"
+              << std::setw(12) << "arena" << std::setw(10) << "bloques" << "  estable" << std::endl;
+
+    compararReutilizacion("count sort paralelo", REPETICIONES, arena,
+        [&] { countSortParalelo(claves_cortas, NUM_THREADS); },
+        [&] {
+            countSortParalelo(claves_cortas.data(), N_ORDENAR, salida_orden, NUM_THREADS, arena);
+            return std::equal(referencia_count.begin(), referencia_count.end(), salida_orden);
+        });
+    compararReutilizacion("count sort secuencial", REPETICIONES, arena,
+        [&] { countSortSecuencial(claves_cortas); },
+        [&] {
+            countSortSecuencial(claves_cortas.data(), N_ORDENAR, salida_orden, arena);
+            return std::equal(referencia_count.begin(), referencia_count.end(), salida_orden);
+        });
+    compararReutilizacion("radix sort (11 bits)", REPETICIONES, arena,
+        [&] { radixSortParalelo(claves, NUM_THREADS, 11); },
+        [&] {
+            radixSortParalelo(claves.data(), N_ORDENAR, salida_orden, NUM_THREADS, arena, 11);
+            return std::equal(referencia_radix.begin(), referencia_radix.end(), salida_orden);
+        });
+    compararReutilizacion("matriz-vector paralelo", REPETICIONES, arena,
+        [&] { multiplicarMatrizVectorParalelo(matriz, vector, NUM_THREADS); },
+        [&] {
+            multiplicarMatrizVectorParalelo(matriz, vector.data(), salida_matvec, NUM_THREADS, arena);
+            return std::equal(referencia_matvec.begin(), referencia_matvec.end(), salida_matvec);
+        });
+
+    auto integrando_pi = [](double x) { return 4.0 / (1.0 + x * x); };
+    double referencia_pi = integrarParalelo(integrando_pi, 0.0, 1.0, 1000000, ReglaIntegracion::SIMPSON, NUM_THREADS);
+    compararReutilizacion("integración (Simpson)", REPETICIONES, arena,
+        [&] { integrarParalelo(integrando_pi, 0.0, 1.0, 1000000, ReglaIntegracion::SIMPSON, NUM_THREADS); },
+        [&] {
+            double pi = integrarParalelo(integrando_pi, 0.0, 1.0, 1000000, ReglaIntegracion::SIMPSON, NUM_THREADS, arena);
+            return pi == referencia_pi;
+        });
+
+    // Sistema simétrico y diagonalmente dominante, como en la sección 6
+    const int N_SISTEMA = 500;
+    std::uniform_real_distribution<> dis_real(0.0, 1.0);
+    std::vector<std::vector<double>> sistema(N_SISTEMA, std::vector<double>(N_SISTEMA));
+    std::vector<double> lado_derecho(N_SISTEMA);
+    for (int i = 0; i < N_SISTEMA; ++i) {
+        for (int j = 0; j < i; ++j) {
+            sistema[i][j] = sistema[j][i] = dis_real(gen);
+        }
+        sistema[i][i] = N_SISTEMA;
+        lado_derecho[i] = dis_real(gen);
+    }
+    auto referencia_cg = resolverIterativo(MetodoIterativo::GRADIENTE_CONJUGADO, sistema, lado_derecho,
+                                           1e-10, 1000, NUM_THREADS);
+    double* solucion = arena.reservar<double>(N_SISTEMA);
+    compararReutilizacion("gradiente conjugado", REPETICIONES, arena,
+        [&] { resolverIterativo(MetodoIterativo::GRADIENTE_CONJUGADO, sistema, lado_derecho, 1e-10, 1000, NUM_THREADS); },
+        [&] {
+            resolverIterativo(MetodoIterativo::GRADIENTE_CONJUGADO, sistema, lado_derecho, 1e-10, 1000, NUM_THREADS,
+                              solucion, arena);
+            return std::equal(referencia_cg.x.begin(), referencia_cg.x.end(), solucion);
+        });
+
+    auto integrando_pico = [](double x) { return 1.0 / (1e-4 + x * x); };
+    compararReutilizacion("cuadratura adaptativa", REPETICIONES, arena,
+        [&] { cuadraturaAdaptativaParalela(integrando_pico, -1.0, 1.0, 1e-10, NUM_THREADS); },
+        [&] {
+            ResultadoAdaptativo r = cuadraturaAdaptativaParalela(integrando_pico, -1.0, 1.0, 1e-10, NUM_THREADS, arena);
+            return std::abs(r.valor - 2.0 * 100.0 * std::atan(100.0)) <= 1e-8;
+        });
+
+    std::cout << "Arena: " << arena.bytesMapeados() / (1 << 20) << " MB mapeados en " << arena.numBloques()
+              << " bloques, " << arena.bytesPaginasEnormes() / (1 << 20) << " MB con páginas enormes" << std::endl;
 }
 
 // ============================================================================
@@ -535,7 +4336,7 @@ void ejecutarCountSort() {
 
 int main() {
     std::cout << "=== REPOSITORIO DE ALGORITMOS PARALELOS CLÁSICOS ===" << std::endl;
-    std::cout << "Implementando 4 algoritmos fundamentales de programación paralela" << std::endl;
+    std::cout << "Implementando 4 algoritmos fundamentales de programación paralela y un pipeline que los combina" << std::endl;
     
     try {
         // Ejecutar todos los algoritmos
@@ -543,6 +4344,12 @@ int main() {
         ejecutarMultiplicacionMatrizVector();
         ejecutarReglaTrapezoidal();
         ejecutarCountSort();
+        ejecutarComparacionOrdenamientos();
+        ejecutarOrdenamientoClaveValor();
+        ejecutarEscaneoParalelo();
+        ejecutarPipeline();
+        ejecutarMetodosIterativos();
+        ejecutarReutilizacionMemoria();
         
         std::cout << "\n=== TODOS LOS ALGORITMOS COMPLETADOS EXITOSAMENTE ===" << std::endl;
         
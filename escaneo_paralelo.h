@@ -0,0 +1,356 @@
+// Escaneo (suma de prefijos) paralelo reutilizable: variantes inclusiva,
+// exclusiva y segmentada sobre cualquier operación asociativa, con backends
+// pthread y OpenMP.
+//
+// Algoritmo de dos pasadas por bloques de caché (reducir y luego escanear,
+// al estilo de Blelloch): el arreglo se recorre en superbloques de
+// TAM_BLOQUE elementos por hilo. En cada superbloque cada hilo reduce su
+// sub-bloque, los hilos se sincronizan una vez, cada uno combina los
+// parciales de los hilos anteriores para obtener su prefijo y escanea su
+// sub-bloque, que sigue en caché tras la reducción. Con la suma sobre tipos
+// aritméticos las dos pasadas se vectorizan con `omp simd` (reducción y
+// `inscan`); el resto de operaciones usa el bucle escalar.
+//
+// Si se pasa una Arena, los parciales y los descriptores de hilo salen de
+// ella y el escaneo no reserva memoria; sin ella van en vectores pequeños.
+#ifndef ESCANEO_PARALELO_H
+#define ESCANEO_PARALELO_H
+
+#include <pthread.h>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <cstddef>
+
+#include "arena.h"
+#include "traza.h"
+
+#if defined(_OPENMP) && !defined(NO_OPENMP)
+#include <omp.h>
+#define ESCANEO_CON_OPENMP 1
+#endif
+
+enum class BackendEscaneo { PTHREAD, OPENMP };
+
+// Barrera reutilizable para hilos pthread (pthread_barrier_t no existe en
+// macOS). La generación evita que un hilo rápido atraviese dos barreras.
+class BarreraHilos {
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    int num_hilos;
+    int esperando;
+    long long generacion;
+
+public:
+    explicit BarreraHilos(int num_hilos) : num_hilos(num_hilos), esperando(0), generacion(0) {}
+
+    void esperar() {
+        std::unique_lock<std::mutex> lock(mutex);
+        long long mi_generacion = generacion;
+        if (++esperando == num_hilos) {
+            esperando = 0;
+            ++generacion;
+            cv.notify_all();
+        } else {
+            cv.wait(lock, [this, mi_generacion] { return generacion != mi_generacion; });
+        }
+    }
+};
+
+namespace escaneo_detalle {
+
+// Elementos por hilo y superbloque: 256 KB de int, dentro de la L2, para que
+// la pasada de escaneo relea desde caché lo que acaba de leer la reducción
+constexpr size_t TAM_BLOQUE = size_t(1) << 16;
+
+template <typename T, typename Op>
+constexpr bool ES_SUMA_VECTORIZABLE =
+    std::is_arithmetic_v<T> && (std::is_same_v<Op, std::plus<T>> || std::is_same_v<Op, std::plus<>>);
+
+template <typename T, typename Op>
+T reducirBloque(const T* entrada, size_t desde, size_t hasta, Op& op, T acumulado) {
+    if constexpr (ES_SUMA_VECTORIZABLE<T, Op>) {
+        #pragma omp simd reduction(+:acumulado)
+        for (size_t i = desde; i < hasta; ++i) {
+            acumulado += entrada[i];
+        }
+    } else {
+        for (size_t i = desde; i < hasta; ++i) {
+            acumulado = op(acumulado, entrada[i]);
+        }
+    }
+    return acumulado;
+}
+
+template <typename T, typename Op>
+void escanearBloqueInclusivo(const T* entrada, T* salida, size_t desde, size_t hasta, Op& op, T acumulado) {
+    if constexpr (ES_SUMA_VECTORIZABLE<T, Op>) {
+        #pragma omp simd reduction(inscan, +:acumulado)
+        for (size_t i = desde; i < hasta; ++i) {
+            acumulado += entrada[i];
+            #pragma omp scan inclusive(acumulado)
+            salida[i] = acumulado;
+        }
+    } else {
+        for (size_t i = desde; i < hasta; ++i) {
+            acumulado = op(acumulado, entrada[i]);
+            salida[i] = acumulado;
+        }
+    }
+}
+
+template <typename T, typename Op>
+void escanearBloqueExclusivo(const T* entrada, T* salida, size_t desde, size_t hasta, Op& op, T acumulado) {
+    // La versión vectorial escribe salida[i] antes de leer entrada[i]: solo
+    // vale cuando el escaneo no es en el sitio
+    if constexpr (ES_SUMA_VECTORIZABLE<T, Op>) {
+        if (entrada != salida) {
+            #pragma omp simd reduction(inscan, +:acumulado)
+            for (size_t i = desde; i < hasta; ++i) {
+                salida[i] = acumulado;
+                #pragma omp scan exclusive(acumulado)
+                acumulado += entrada[i];
+            }
+            return;
+        }
+    }
+    for (size_t i = desde; i < hasta; ++i) {
+        T valor = entrada[i];
+        salida[i] = acumulado;
+        acumulado = op(acumulado, valor);
+    }
+}
+
+// Acumulado de un tramo en el escaneo segmentado: si el tramo contiene un
+// inicio de segmento, valor solo cubre desde el último inicio
+template <typename T>
+struct TramoSegmentado {
+    bool tiene_inicio;
+    T valor;
+};
+
+// Parcial de un hilo en un superbloque. Las dos ranuras alternan entre
+// superbloques, así basta una barrera por superbloque.
+template <typename A>
+struct alignas(64) ParcialEscaneo {
+    A valor[2];
+};
+
+// Cuerpo de cada hilo, común a los dos backends
+template <typename A, typename Reducir, typename Combinar, typename Escanear, typename Esperar>
+void recorrerSuperbloques(int id, int num_hilos, size_t n, const A& identidad, ParcialEscaneo<A>* parciales,
+                          Reducir& reducir, Combinar& combinar, Escanear& escanear, Esperar esperar) {
+    A acarreo = identidad;
+    int ranura = 0;
+    size_t paso = TAM_BLOQUE * num_hilos;
+
+    for (size_t base = 0; base < n; base += paso) {
+        size_t fin = std::min(base + paso, n);
+        size_t por_hilo = (fin - base + num_hilos - 1) / num_hilos;
+        size_t desde = std::min(base + id * por_hilo, fin);
+        size_t hasta = std::min(desde + por_hilo, fin);
+
+        {
+            AmbitoTraza traza("escaneo:reducir", hasta - desde);
+            parciales[id].valor[ranura] = reducir(desde, hasta);
+        }
+        {
+            AmbitoTraza traza("escaneo:barrera");
+            esperar();
+        }
+
+        // Todos los hilos recorren los mismos parciales en el mismo orden,
+        // así el acarreo al siguiente superbloque coincide en todos
+        A prefijo = acarreo;
+        for (int t = 0; t < id; ++t) {
+            prefijo = combinar(prefijo, parciales[t].valor[ranura]);
+        }
+        A total = prefijo;
+        for (int t = id; t < num_hilos; ++t) {
+            total = combinar(total, parciales[t].valor[ranura]);
+        }
+
+        {
+            AmbitoTraza traza("escaneo:escanear", hasta - desde);
+            escanear(desde, hasta, prefijo);
+        }
+        acarreo = total;
+        ranura ^= 1;
+    }
+}
+
+template <typename Trabajo>
+struct HiloEscaneo {
+    Trabajo* trabajo;
+    int id;
+};
+
+template <typename Trabajo>
+void* ejecutarHiloEscaneo(void* arg) {
+    HiloEscaneo<Trabajo>* datos = static_cast<HiloEscaneo<Trabajo>*>(arg);
+    (*datos->trabajo)(datos->id);
+    return nullptr;
+}
+
+// Espacio de trabajo de n elementos: de la arena si la hay y el tipo se
+// puede copiar byte a byte; si no, del vector `propio`, que basta para los
+// pocos descriptores por hilo del escaneo
+template <typename T>
+T* reservarTrabajo(Arena* arena, std::vector<T>& propio, size_t n) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        if (arena != nullptr) {
+            return arena->reservar<T>(n);
+        }
+    }
+    propio.resize(n);
+    return propio.data();
+}
+
+// Motor genérico: reducir(desde, hasta) devuelve el acumulado de un tramo,
+// combinar es la operación asociativa sobre acumulados y escanear(desde,
+// hasta, prefijo) escribe el tramo partiendo del prefijo recibido
+template <typename A, typename Reducir, typename Combinar, typename Escanear>
+void motorEscaneo(size_t n, int num_hilos, BackendEscaneo backend, Arena* arena, const A& identidad,
+                  Reducir reducir, Combinar combinar, Escanear escanear) {
+    // Con un solo superbloque no hay nada que repartir: una pasada basta
+    if (num_hilos <= 1 || n <= TAM_BLOQUE) {
+        AmbitoTraza traza("escaneo:secuencial", n);
+        escanear(0, n, identidad);
+        return;
+    }
+
+    std::optional<AmbitoArena> ambito;
+    if (arena != nullptr) {
+        ambito.emplace(*arena);
+    }
+
+    std::vector<ParcialEscaneo<A>> parciales_propios;
+    ParcialEscaneo<A>* parciales = reservarTrabajo(arena, parciales_propios, num_hilos);
+
+#ifdef ESCANEO_CON_OPENMP
+    if (backend == BackendEscaneo::OPENMP) {
+        #pragma omp parallel num_threads(num_hilos)
+        {
+            // OpenMP puede conceder menos hilos de los pedidos
+            int hilos = omp_get_num_threads();
+            recorrerSuperbloques(omp_get_thread_num(), hilos, n, identidad, parciales,
+                                 reducir, combinar, escanear, [] {
+                                     #pragma omp barrier
+                                 });
+        }
+        return;
+    }
+#else
+    (void)backend;
+#endif
+
+    BarreraHilos barrera(num_hilos);
+    auto trabajo = [&](int id) {
+        recorrerSuperbloques(id, num_hilos, n, identidad, parciales,
+                             reducir, combinar, escanear, [&barrera] { barrera.esperar(); });
+    };
+
+    using Trabajo = decltype(trabajo);
+    std::vector<pthread_t> threads_propios;
+    std::vector<HiloEscaneo<Trabajo>> thread_data_propios;
+    pthread_t* threads = reservarTrabajo(arena, threads_propios, num_hilos);
+    HiloEscaneo<Trabajo>* thread_data = reservarTrabajo(arena, thread_data_propios, num_hilos);
+
+    {
+        AmbitoTraza traza("escaneo:crear hilos", num_hilos);
+        for (int i = 0; i < num_hilos; ++i) {
+            thread_data[i] = {&trabajo, i};
+            pthread_create(&threads[i], nullptr, ejecutarHiloEscaneo<Trabajo>, &thread_data[i]);
+        }
+    }
+
+    AmbitoTraza traza("escaneo:unir hilos", num_hilos);
+    for (int i = 0; i < num_hilos; ++i) {
+        pthread_join(threads[i], nullptr);
+    }
+}
+
+} // namespace escaneo_detalle
+
+// salida[i] = entrada[0] op ... op entrada[i]. Admite entrada == salida.
+template <typename T, typename Op = std::plus<T>>
+void escaneoInclusivo(const T* entrada, T* salida, size_t n, int num_hilos,
+                      Op op = Op(), T identidad = T(), BackendEscaneo backend = BackendEscaneo::PTHREAD,
+                      Arena* arena = nullptr) {
+    using namespace escaneo_detalle;
+    motorEscaneo(n, num_hilos, backend, arena, identidad,
+        [&](size_t desde, size_t hasta) { return reducirBloque(entrada, desde, hasta, op, identidad); },
+        [&](const T& a, const T& b) { return op(a, b); },
+        [&](size_t desde, size_t hasta, const T& prefijo) {
+            escanearBloqueInclusivo(entrada, salida, desde, hasta, op, prefijo);
+        });
+}
+
+// salida[i] = identidad op entrada[0] op ... op entrada[i-1]. Admite
+// entrada == salida.
+template <typename T, typename Op = std::plus<T>>
+void escaneoExclusivo(const T* entrada, T* salida, size_t n, int num_hilos,
+                      Op op = Op(), T identidad = T(), BackendEscaneo backend = BackendEscaneo::PTHREAD,
+                      Arena* arena = nullptr) {
+    using namespace escaneo_detalle;
+    motorEscaneo(n, num_hilos, backend, arena, identidad,
+        [&](size_t desde, size_t hasta) { return reducirBloque(entrada, desde, hasta, op, identidad); },
+        [&](const T& a, const T& b) { return op(a, b); },
+        [&](size_t desde, size_t hasta, const T& prefijo) {
+            escanearBloqueExclusivo(entrada, salida, desde, hasta, op, prefijo);
+        });
+}
+
+// Escaneo segmentado: inicio_segmento[i] != 0 marca que entrada[i] abre un
+// segmento nuevo y el acumulado vuelve a la identidad. Con inclusivo = false
+// cada segmento recibe un escaneo exclusivo propio.
+template <typename T, typename Op = std::plus<T>>
+void escaneoSegmentado(const T* entrada, const unsigned char* inicio_segmento, T* salida, size_t n,
+                       int num_hilos, bool inclusivo = true, Op op = Op(), T identidad = T(),
+                       BackendEscaneo backend = BackendEscaneo::PTHREAD, Arena* arena = nullptr) {
+    using namespace escaneo_detalle;
+    using Tramo = TramoSegmentado<T>;
+
+    auto reducir = [&](size_t desde, size_t hasta) {
+        Tramo tramo{false, identidad};
+        for (size_t i = desde; i < hasta; ++i) {
+            if (inicio_segmento[i]) {
+                tramo.tiene_inicio = true;
+                tramo.valor = identidad;
+            }
+            tramo.valor = op(tramo.valor, entrada[i]);
+        }
+        return tramo;
+    };
+
+    // Operación segmentada: un inicio en el tramo derecho corta el acumulado
+    // del izquierdo. Es asociativa si op lo es.
+    auto combinar = [&](const Tramo& a, const Tramo& b) {
+        if (b.tiene_inicio) return b;
+        return Tramo{a.tiene_inicio, op(a.valor, b.valor)};
+    };
+
+    auto escanear = [&](size_t desde, size_t hasta, const Tramo& prefijo) {
+        T acumulado = prefijo.valor;
+        for (size_t i = desde; i < hasta; ++i) {
+            if (inicio_segmento[i]) acumulado = identidad;
+            T valor = entrada[i];
+            if (inclusivo) {
+                acumulado = op(acumulado, valor);
+                salida[i] = acumulado;
+            } else {
+                salida[i] = acumulado;
+                acumulado = op(acumulado, valor);
+            }
+        }
+    };
+
+    motorEscaneo(n, num_hilos, backend, arena, Tramo{false, identidad}, reducir, combinar, escanear);
+}
+
+#endif // ESCANEO_PARALELO_H
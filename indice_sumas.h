@@ -0,0 +1,391 @@
+// Índice incremental de sumas por rango sobre un arreglo de int.
+//
+// Árbol de Fenwick por bloques: el arreglo se divide en hojas de TAM_HOJA
+// elementos contiguos y el árbol sólo guarda sumas de hoja, así que ocupa
+// TAM_HOJA veces menos que el arreglo y sus niveles altos viven en caché.
+// Dentro de una hoja la suma parcial es un bucle SIMD sobre memoria contigua.
+// Sumar a un rango edita elemento a elemento sólo las dos hojas de los
+// extremos; las hojas completas del medio se marcan con el par clásico de
+// árboles de Fenwick "sumar en rango / consultar prefijo", sin recorrerlas.
+// Actualizaciones y consultas cuestan O(log(n / TAM_HOJA) + TAM_HOJA).
+//
+// Los lotes se aplican en paralelo con hilos pthread: las consultas se
+// reparten por trozos y las actualizaciones por rangos de nodos del árbol
+// (ver actualizarLote).
+#ifndef INDICE_SUMAS_H
+#define INDICE_SUMAS_H
+
+#include <pthread.h>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+#include "arena.h"
+#include "traza.h"
+
+// Sumar delta a los elementos [inicio, fin)
+struct ActualizacionRango {
+    size_t inicio;
+    size_t fin;
+    int delta;
+};
+
+// Suma de los elementos [inicio, fin)
+struct ConsultaRango {
+    size_t inicio;
+    size_t fin;
+};
+
+class IndiceSumas {
+public:
+    static constexpr size_t TAM_HOJA = 64; // 256 bytes: cuatro líneas de caché
+
+    explicit IndiceSumas(const std::vector<int>& arreglo)
+        : n(arreglo.size()),
+          num_hojas((arreglo.size() + TAM_HOJA - 1) / TAM_HOJA),
+          valores(num_hojas * TAM_HOJA, 0),
+          hojas(num_hojas + 1, 0),
+          perezoso(num_hojas + 1, NodoPerezoso{0, 0}) {
+        std::copy(arreglo.begin(), arreglo.end(), valores.begin());
+
+        // Sumas de hoja en paralelo y construcción lineal del árbol
+        #pragma omp parallel for
+        for (size_t b = 0; b < num_hojas; ++b) {
+            hojas[b + 1] = sumarHoja(valores.data() + b * TAM_HOJA, TAM_HOJA);
+        }
+        for (size_t i = 1; i <= num_hojas; ++i) {
+            size_t padre = i + (i & -i);
+            if (padre <= num_hojas) {
+                hojas[padre] += hojas[i];
+            }
+        }
+    }
+
+    size_t size() const { return n; }
+
+    int valor(size_t i) const {
+        return valores[i] + static_cast<int>(prefijoPerezoso(i / TAM_HOJA + 1).delta);
+    }
+
+    void sumar(size_t i, int delta) { sumarRango(i, i + 1, delta); }
+
+    void asignar(size_t i, int nuevo) { sumar(i, nuevo - valor(i)); }
+
+    void sumarRango(size_t inicio, size_t fin, int delta) {
+        descomponer(inicio, fin,
+            [&](size_t desde, size_t hasta) {
+                size_t nodo = editarHoja(desde, hasta, delta);
+                subirHojas(nodo, static_cast<long long>(delta) * (hasta - desde), num_hojas + 1);
+            },
+            [&](size_t nodo, int signo) {
+                subirPerezoso(nodo, marcaPerezosa(nodo, signo * delta), num_hojas + 1);
+            });
+    }
+
+    // Suma de los elementos [0, i)
+    long long prefijo(size_t i) const {
+        size_t hoja = i / TAM_HOJA;
+        size_t desplazamiento = i % TAM_HOJA;
+
+        long long suma = 0;
+        for (size_t k = hoja; k > 0; k -= k & -k) {
+            suma += hojas[k];
+        }
+        NodoPerezoso marcas = prefijoPerezoso(hoja);
+        suma += static_cast<long long>(TAM_HOJA) * (marcas.delta * static_cast<long long>(hoja) - marcas.ponderado);
+
+        if (desplazamiento > 0) {
+            suma += sumarHoja(valores.data() + hoja * TAM_HOJA, desplazamiento);
+            suma += static_cast<long long>(desplazamiento) * prefijoPerezoso(hoja + 1).delta;
+        }
+        return suma;
+    }
+
+    long long sumaRango(size_t inicio, size_t fin) const {
+        return prefijo(fin) - prefijo(inicio);
+    }
+
+    long long total() const { return prefijo(n); }
+
+    // Aplica un lote de actualizaciones en paralelo. Cada hilo es dueño de
+    // un rango contiguo de nodos del árbol (y de las hojas correspondientes)
+    // y antes de lanzar los hilos el lote se reparte por dueño, partiendo en
+    // las fronteras los rangos que cruzan de un hilo a otro: cada hilo sólo
+    // descompone sus trozos y los hilos nunca escriben el mismo nodo. Cuando
+    // la cadena de un nodo sale del rango del hilo, el resto se acumula por
+    // nodo de salida; como todas las cadenas que salen pasan por los
+    // ancestros del último nodo del rango (o empiezan en el primer nodo del
+    // hilo siguiente, la marca de cierre de un trozo que llega a la
+    // frontera), hay a lo sumo log2(hojas) + 2 salidas distintas, que el
+    // hilo principal aplica al final.
+    void actualizarLote(const ActualizacionRango* lote, size_t cantidad, int num_hilos, Arena& arena) {
+        num_hilos = static_cast<int>(std::max<size_t>(1, std::min<size_t>(num_hilos, num_hojas)));
+        AmbitoArena ambito(arena);
+        pthread_t* threads = arena.reservar<pthread_t>(num_hilos);
+        LoteActualizacionData* thread_data = arena.reservar<LoteActualizacionData>(num_hilos);
+
+        size_t nodos_por_hilo = (num_hojas + num_hilos - 1) / num_hilos;
+        const ActualizacionRango* repartido;
+        size_t* comienzo = repartirLote(lote, cantidad, num_hilos, nodos_por_hilo * TAM_HOJA, arena, repartido);
+        {
+            AmbitoTraza traza("indice:crear hilos", num_hilos);
+            for (int i = 0; i < num_hilos; ++i) {
+                thread_data[i].indice = this;
+                thread_data[i].lote = repartido + comienzo[i];
+                thread_data[i].cantidad = comienzo[i + 1] - comienzo[i];
+                thread_data[i].nodo_inicio = std::min(1 + i * nodos_por_hilo, num_hojas + 1);
+                thread_data[i].nodo_fin = std::min(1 + (i + 1) * nodos_por_hilo, num_hojas + 1);
+                pthread_create(&threads[i], nullptr, actualizarTrozo, &thread_data[i]);
+            }
+        }
+        {
+            AmbitoTraza traza("indice:unir hilos", num_hilos);
+            for (int i = 0; i < num_hilos; ++i) {
+                pthread_join(threads[i], nullptr);
+            }
+        }
+
+        AmbitoTraza traza("indice:aplicar salidas", num_hilos);
+        for (int i = 0; i < num_hilos; ++i) {
+            const LoteActualizacionData& data = thread_data[i];
+            for (size_t s = 0; s < data.salidas_hojas.cantidad; ++s) {
+                subirHojas(data.salidas_hojas.nodos[s], data.salidas_hojas.valores[s].delta, num_hojas + 1);
+            }
+            for (size_t s = 0; s < data.salidas_perezosas.cantidad; ++s) {
+                subirPerezoso(data.salidas_perezosas.nodos[s], data.salidas_perezosas.valores[s], num_hojas + 1);
+            }
+        }
+    }
+
+    // Responde un lote de consultas en paralelo; resultados[k] corresponde
+    // a lote[k]. Las consultas sólo leen, así que basta repartirlas.
+    void consultarLote(const ConsultaRango* lote, size_t cantidad, long long* resultados,
+                       int num_hilos, Arena& arena) const {
+        num_hilos = static_cast<int>(std::max<size_t>(1, std::min<size_t>(num_hilos, cantidad)));
+        AmbitoArena ambito(arena);
+        pthread_t* threads = arena.reservar<pthread_t>(num_hilos);
+        LoteConsultaData* thread_data = arena.reservar<LoteConsultaData>(num_hilos);
+
+        size_t chunk_size = cantidad / num_hilos;
+        {
+            AmbitoTraza traza("indice:crear hilos", num_hilos);
+            for (int i = 0; i < num_hilos; ++i) {
+                thread_data[i].indice = this;
+                thread_data[i].lote = lote;
+                thread_data[i].resultados = resultados;
+                thread_data[i].start = i * chunk_size;
+                thread_data[i].end = (i == num_hilos - 1) ? cantidad : (i + 1) * chunk_size;
+                pthread_create(&threads[i], nullptr, consultarTrozo, &thread_data[i]);
+            }
+        }
+
+        AmbitoTraza traza("indice:unir hilos", num_hilos);
+        for (int i = 0; i < num_hilos; ++i) {
+            pthread_join(threads[i], nullptr);
+        }
+    }
+
+private:
+    // Marcas de las hojas completas: delta y delta·(nodo - 1) van juntos
+    // porque siempre se actualizan y se consultan en el mismo nodo
+    struct NodoPerezoso {
+        long long delta;
+        long long ponderado;
+
+        NodoPerezoso& operator+=(const NodoPerezoso& otro) {
+            delta += otro.delta;
+            ponderado += otro.ponderado;
+            return *this;
+        }
+    };
+
+    // Sumas pendientes por nodo de salida: los ancestros del último nodo
+    // (64 cubren cualquier size_t) más el primer nodo del hilo siguiente
+    static constexpr size_t MAX_SALIDAS = 66;
+
+    struct SalidasNodo {
+        size_t nodos[MAX_SALIDAS];
+        NodoPerezoso valores[MAX_SALIDAS]; // Para el árbol de hojas sólo se usa delta
+        size_t cantidad;
+
+        void acumular(size_t nodo, NodoPerezoso valor) {
+            for (size_t s = 0; s < cantidad; ++s) {
+                if (nodos[s] == nodo) {
+                    valores[s] += valor;
+                    return;
+                }
+            }
+            nodos[cantidad] = nodo;
+            valores[cantidad] = valor;
+            ++cantidad;
+        }
+    };
+
+    struct LoteActualizacionData {
+        IndiceSumas* indice;
+        const ActualizacionRango* lote; // Sólo los trozos de este hilo
+        size_t cantidad;
+        size_t nodo_inicio, nodo_fin; // Nodos propios [nodo_inicio, nodo_fin)
+        SalidasNodo salidas_hojas;
+        SalidasNodo salidas_perezosas;
+    };
+
+    struct LoteConsultaData {
+        const IndiceSumas* indice;
+        const ConsultaRango* lote;
+        long long* resultados;
+        size_t start, end;
+    };
+
+    size_t n;
+    size_t num_hojas;
+    std::vector<int> valores;            // Relleno con ceros hasta num_hojas·TAM_HOJA
+    std::vector<long long> hojas;        // Fenwick de sumas de hoja, base 1
+    std::vector<NodoPerezoso> perezoso;  // Fenwick de marcas de hojas completas, base 1
+
+    static long long sumarHoja(const int* hoja, size_t cantidad) {
+        long long suma = 0;
+        #pragma omp simd reduction(+:suma)
+        for (size_t j = 0; j < cantidad; ++j) {
+            suma += hoja[j];
+        }
+        return suma;
+    }
+
+    NodoPerezoso prefijoPerezoso(size_t nodo) const {
+        NodoPerezoso suma{0, 0};
+        for (size_t k = nodo; k > 0; k -= k & -k) {
+            suma += perezoso[k];
+        }
+        return suma;
+    }
+
+    // Suma de prefijos de marcas: si las hojas [a, b] (base 1) reciben d,
+    // el nodo a gana (d, d·(a-1)) y el nodo b+1 gana (-d, -d·b)
+    static NodoPerezoso marcaPerezosa(size_t nodo, int delta) {
+        return {delta, static_cast<long long>(delta) * static_cast<long long>(nodo - 1)};
+    }
+
+    // Reparte [inicio, fin) en tramos dentro de una hoja (como mucho dos,
+    // en los extremos) y marcas con signo en los nodos que delimitan las
+    // hojas completas
+    template <typename Editar, typename Marcar>
+    void descomponer(size_t inicio, size_t fin, Editar editar, Marcar marcar) const {
+        if (inicio >= fin) return;
+        size_t primera_completa = (inicio + TAM_HOJA - 1) / TAM_HOJA;
+        size_t fin_completas = fin / TAM_HOJA;
+
+        if (primera_completa >= fin_completas) {
+            size_t corte = std::min(fin, primera_completa * TAM_HOJA);
+            if (inicio < corte) editar(inicio, corte);
+            if (corte < fin) editar(corte, fin);
+            return;
+        }
+
+        if (inicio < primera_completa * TAM_HOJA) editar(inicio, primera_completa * TAM_HOJA);
+        if (fin_completas * TAM_HOJA < fin) editar(fin_completas * TAM_HOJA, fin);
+        marcar(primera_completa + 1, 1);
+        marcar(fin_completas + 1, -1);
+    }
+
+    // Edita [desde, hasta), dentro de una sola hoja, y devuelve su nodo
+    size_t editarHoja(size_t desde, size_t hasta, int delta) {
+        #pragma omp simd
+        for (size_t i = desde; i < hasta; ++i) {
+            valores[i] += delta;
+        }
+        return desde / TAM_HOJA + 1;
+    }
+
+    // Suben por el árbol hasta `limite` (exclusivo) y devuelven el nodo en
+    // el que se pararon
+    size_t subirHojas(size_t nodo, long long delta, size_t limite) {
+        for (; nodo < limite; nodo += nodo & -nodo) {
+            hojas[nodo] += delta;
+        }
+        return nodo;
+    }
+
+    size_t subirPerezoso(size_t nodo, NodoPerezoso marca, size_t limite) {
+        for (; nodo < limite; nodo += nodo & -nodo) {
+            perezoso[nodo] += marca;
+        }
+        return nodo;
+    }
+
+    // Reparte el lote entre los hilos dueños de `elementos_por_hilo`
+    // elementos consecutivos, en dos pasadas (contar y colocar). Devuelve
+    // el comienzo de los trozos de cada hilo en `repartido` (num_hilos + 1
+    // posiciones).
+    static size_t* repartirLote(const ActualizacionRango* lote, size_t cantidad, int num_hilos,
+                                size_t elementos_por_hilo, Arena& arena, const ActualizacionRango*& repartido) {
+        AmbitoTraza traza("indice:repartir lote", cantidad);
+        size_t* comienzo = arena.reservar<size_t>(num_hilos + 1);
+        std::fill(comienzo, comienzo + num_hilos + 1, 0);
+        for (size_t k = 0; k < cantidad; ++k) {
+            const ActualizacionRango& a = lote[k];
+            if (a.inicio >= a.fin) continue;
+            for (size_t t = a.inicio / elementos_por_hilo; t <= (a.fin - 1) / elementos_por_hilo; ++t) {
+                ++comienzo[t + 1];
+            }
+        }
+        for (int t = 0; t < num_hilos; ++t) {
+            comienzo[t + 1] += comienzo[t];
+        }
+
+        ActualizacionRango* trozos = arena.reservar<ActualizacionRango>(comienzo[num_hilos]);
+        size_t* siguiente = arena.reservar<size_t>(num_hilos);
+        std::copy(comienzo, comienzo + num_hilos, siguiente);
+        for (size_t k = 0; k < cantidad; ++k) {
+            const ActualizacionRango& a = lote[k];
+            if (a.inicio >= a.fin) continue;
+            for (size_t t = a.inicio / elementos_por_hilo; t <= (a.fin - 1) / elementos_por_hilo; ++t) {
+                trozos[siguiente[t]++] = {std::max(a.inicio, t * elementos_por_hilo),
+                                          std::min(a.fin, (t + 1) * elementos_por_hilo), a.delta};
+            }
+        }
+        repartido = trozos;
+        return comienzo;
+    }
+
+    // Los trozos del hilo sólo tocan sus nodos, salvo la marca de cierre de
+    // un trozo que acaba en la frontera, que cae en el nodo `fin` y sale
+    // directamente como salida
+    static void* actualizarTrozo(void* arg) {
+        LoteActualizacionData* data = static_cast<LoteActualizacionData*>(arg);
+        IndiceSumas& indice = *data->indice;
+        AmbitoTraza traza("indice:actualizar trozo", data->nodo_fin - data->nodo_inicio);
+        const size_t fin = data->nodo_fin;
+        const size_t raiz = indice.num_hojas + 1;
+        data->salidas_hojas.cantidad = 0;
+        data->salidas_perezosas.cantidad = 0;
+
+        for (size_t k = 0; k < data->cantidad; ++k) {
+            const ActualizacionRango& a = data->lote[k];
+            indice.descomponer(a.inicio, a.fin,
+                [&](size_t desde, size_t hasta) {
+                    size_t nodo = indice.editarHoja(desde, hasta, a.delta);
+                    long long suma = static_cast<long long>(a.delta) * (hasta - desde);
+                    size_t salida = indice.subirHojas(nodo, suma, fin);
+                    if (salida < raiz) data->salidas_hojas.acumular(salida, {suma, 0});
+                },
+                [&](size_t nodo, int signo) {
+                    NodoPerezoso marca = marcaPerezosa(nodo, signo * a.delta);
+                    size_t salida = indice.subirPerezoso(nodo, marca, fin);
+                    if (salida < raiz) data->salidas_perezosas.acumular(salida, marca);
+                });
+        }
+        return nullptr;
+    }
+
+    static void* consultarTrozo(void* arg) {
+        LoteConsultaData* data = static_cast<LoteConsultaData*>(arg);
+        AmbitoTraza traza("indice:consultar trozo", data->end - data->start);
+        for (size_t k = data->start; k < data->end; ++k) {
+            data->resultados[k] = data->indice->sumaRango(data->lote[k].inicio, data->lote[k].fin);
+        }
+        return nullptr;
+    }
+};
+
+#endif // INDICE_SUMAS_H
@@ -0,0 +1,190 @@
+// Trazas de ejecución por hilo en formato Chrome/Perfetto.
+//
+// Con la variable de entorno TRAZA_CHROME=archivo.json, cada AmbitoTraza
+// registra un evento completo (inicio y duración) en el carril del hilo que
+// lo crea, y al terminar el programa se vuelcan todos los carriles como JSON
+// que abren chrome://tracing y ui.perfetto.dev. Sin la variable, crear un
+// AmbitoTraza sólo cuesta comprobar un booleano.
+//
+// Cada carril es un buffer circular de tamaño fijo con un único escritor:
+// registrar un evento no toma locks ni reserva memoria; si el buffer se
+// llena se pierden los eventos más antiguos, y cuántos se perdieron queda en
+// los metadatos del carril (eventos_perdidos). Los hilos fork-join viven poco,
+// así que al terminar un hilo su carril vuelve a un pool y lo reutiliza el
+// siguiente hilo que trace. Cada carril es entonces una "vía" de trabajo
+// en la línea de tiempo y el número de carriles coincide con el máximo de
+// hilos vivos a la vez. El hilo principal es la excepción: tiene un carril
+// propio que no entra al pool, y es el único que se llama "principal".
+//
+// Los nombres de los eventos deben ser literales: se guarda el puntero.
+#ifndef TRAZA_H
+#define TRAZA_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <memory>
+
+class Traza {
+public:
+    static constexpr size_t CAPACIDAD_CARRIL = size_t(1) << 15; // Eventos por carril
+
+    struct Evento {
+        const char* nombre;
+        long long trabajo;    // Elementos procesados, o -1 si no aplica
+        uint64_t inicio_ns;
+        uint64_t duracion_ns;
+    };
+
+    static bool activa() { return estado().ruta != nullptr; }
+
+    static uint64_t ahora() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static void registrar(const char* nombre, uint64_t inicio_ns, uint64_t fin_ns, long long trabajo) {
+        Carril* carril = carrilDelHilo();
+        if (carril->escritos >= CAPACIDAD_CARRIL) {
+            ++carril->perdidos;
+        }
+        carril->eventos[carril->escritos % CAPACIDAD_CARRIL] = {nombre, trabajo, inicio_ns, fin_ns - inicio_ns};
+        ++carril->escritos;
+    }
+
+    // Escribe todos los carriles en la ruta de TRAZA_CHROME. Se llama sola
+    // al salir del programa.
+    static void volcar() {
+        Estado& e = estado();
+        if (e.ruta == nullptr) return;
+
+        std::lock_guard<std::mutex> lock(e.mutex);
+        FILE* archivo = std::fopen(e.ruta, "w");
+        if (archivo == nullptr) {
+            std::fprintf(stderr, "No se pudo escribir la traza en %s\n", e.ruta);
+            return;
+        }
+
+        std::fprintf(archivo, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+        bool primero = true;
+        uint64_t total_perdidos = 0;
+        for (size_t c = 0; c < e.carriles.size(); ++c) {
+            const Carril& carril = *e.carriles[c];
+            std::fprintf(archivo, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,"
+                         "\"args\":{\"name\":\"%s %zu\",\"eventos_perdidos\":%llu}}",
+                         primero ? "" : ",\n", c, carril.principal ? "principal" : "carril", c,
+                         static_cast<unsigned long long>(carril.perdidos));
+            primero = false;
+            total_perdidos += carril.perdidos;
+
+            uint64_t desde = carril.escritos > CAPACIDAD_CARRIL ? carril.escritos - CAPACIDAD_CARRIL : 0;
+            for (uint64_t i = desde; i < carril.escritos; ++i) {
+                const Evento& ev = carril.eventos[i % CAPACIDAD_CARRIL];
+                std::fprintf(archivo, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,"
+                             "\"ts\":%.3f,\"dur\":%.3f",
+                             ev.nombre, c, (ev.inicio_ns - e.origen_ns) / 1000.0, ev.duracion_ns / 1000.0);
+                if (ev.trabajo >= 0) {
+                    std::fprintf(archivo, ",\"args\":{\"trabajo\":%lld}", ev.trabajo);
+                }
+                std::fprintf(archivo, "}");
+            }
+        }
+        std::fprintf(archivo, "\n]}\n");
+        std::fclose(archivo);
+
+        if (total_perdidos > 0) {
+            std::fprintf(stderr, "Traza: se perdieron %llu eventos antiguos (carriles de %zu eventos)\n",
+                         static_cast<unsigned long long>(total_perdidos), CAPACIDAD_CARRIL);
+        }
+    }
+
+private:
+    struct Carril {
+        std::unique_ptr<Evento[]> eventos{new Evento[CAPACIDAD_CARRIL]};
+        uint64_t escritos = 0;
+        uint64_t perdidos = 0;  // Eventos sobrescritos por el buffer circular
+        bool principal = false; // Carril exclusivo del hilo principal
+    };
+
+    // Estado global; nunca se destruye para que el volcado en atexit y los
+    // hilos que terminen tarde lo encuentren vivo
+    struct Estado {
+        const char* ruta;
+        uint64_t origen_ns;
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Carril>> carriles;
+        std::vector<Carril*> libres;
+    };
+
+    // Se inicializa antes de main, por lo tanto en el hilo principal
+    static inline const std::thread::id hilo_principal = std::this_thread::get_id();
+
+    static Estado& estado() {
+        static Estado* e = [] {
+            Estado* nuevo = new Estado{std::getenv("TRAZA_CHROME"), ahora(), {}, {}, {}};
+            if (nuevo->ruta != nullptr) {
+                std::atexit(volcar);
+            }
+            return nuevo;
+        }();
+        return *e;
+    }
+
+    // Devuelve el carril al pool cuando termina el hilo
+    struct PoseedorCarril {
+        Carril* carril = nullptr;
+
+        ~PoseedorCarril() {
+            if (carril != nullptr && !carril->principal) {
+                Estado& e = estado();
+                std::lock_guard<std::mutex> lock(e.mutex);
+                e.libres.push_back(carril);
+            }
+        }
+    };
+
+    static Carril* carrilDelHilo() {
+        thread_local PoseedorCarril poseedor;
+        if (poseedor.carril == nullptr) {
+            Estado& e = estado();
+            std::lock_guard<std::mutex> lock(e.mutex);
+            bool principal = std::this_thread::get_id() == hilo_principal;
+            if (!principal && !e.libres.empty()) {
+                poseedor.carril = e.libres.back();
+                e.libres.pop_back();
+            } else {
+                e.carriles.push_back(std::make_unique<Carril>());
+                poseedor.carril = e.carriles.back().get();
+                poseedor.carril->principal = principal;
+            }
+        }
+        return poseedor.carril;
+    }
+};
+
+// Registra como un evento el tiempo entre su construcción y su destrucción
+class AmbitoTraza {
+public:
+    explicit AmbitoTraza(const char* nombre, long long trabajo = -1)
+        : nombre(nombre), trabajo(trabajo), inicio(Traza::activa() ? Traza::ahora() : 0) {}
+
+    ~AmbitoTraza() {
+        if (inicio != 0) {
+            Traza::registrar(nombre, inicio, Traza::ahora(), trabajo);
+        }
+    }
+
+    AmbitoTraza(const AmbitoTraza&) = delete;
+    AmbitoTraza& operator=(const AmbitoTraza&) = delete;
+
+private:
+    const char* nombre;
+    long long trabajo;
+    uint64_t inicio;
+};
+
+#endif // TRAZA_H